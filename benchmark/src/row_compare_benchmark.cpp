@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <munin/detail/row_compare.hpp>
+#include <terminalpp/element.hpp>
+
+#include <span>
+#include <vector>
+
+using munin::compact_canvas;
+
+namespace {
+
+// ==========================================================================
+// COMPARE_FRAMES
+// ==========================================================================
+// Compares two frames of the given size row by row, in which either no
+// cells or one cell in the middle of each row differs, and reports the
+// rate at which cells were compared.
+template <auto Compare>
+void compare_frames(benchmark::State &state)
+{
+    auto const width = static_cast<std::size_t>(state.range(0));
+    auto const height = static_cast<std::size_t>(state.range(1));
+    bool const has_changes = state.range(2) != 0;
+
+    std::vector<compact_canvas::cell> const previous(
+        width * height, compact_canvas::cell{' ', 0});
+    auto current = previous;
+
+    if (has_changes)
+    {
+        for (std::size_t row = 0; row < height; ++row)
+        {
+            current[row * width + width / 2].glyph_ = '*';
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (std::size_t row = 0; row < height; ++row)
+        {
+            auto const offset = row * width;
+
+            benchmark::DoNotOptimize(Compare(
+                std::span{current}.subspan(offset, width),
+                std::span{previous}.subspan(offset, width)));
+        }
+    }
+
+    state.counters["cells"] = benchmark::Counter(
+        static_cast<double>(width * height),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// ==========================================================================
+// ENCODE_FRAMES
+// ==========================================================================
+// Encodes a frame of the given size row by row, as the window does to each
+// damaged row before comparing it, and reports the rate at which cells were
+// encoded.  This is the other half of the cost of comparing a row.
+void encode_frames(benchmark::State &state)
+{
+    auto const width = static_cast<std::size_t>(state.range(0));
+    auto const height = static_cast<std::size_t>(state.range(1));
+
+    std::vector<terminalpp::element> const elements(
+        width * height, terminalpp::element{'x'});
+    std::vector<compact_canvas::cell> cells(width);
+    compact_canvas last_frame{terminalpp::extent{
+        static_cast<terminalpp::coordinate_type>(width),
+        static_cast<terminalpp::coordinate_type>(height)}};
+
+    for (auto _ : state)
+    {
+        for (std::size_t row = 0; row < height; ++row)
+        {
+            last_frame.encode(
+                std::span{elements}.subspan(row * width, width), cells);
+            benchmark::DoNotOptimize(cells.data());
+        }
+    }
+
+    state.counters["cells"] = benchmark::Counter(
+        static_cast<double>(width * height),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+constexpr auto compare_row = munin::detail::compare_row;
+constexpr auto compare_row_scalar = munin::detail::compare_row_scalar;
+
+}  // namespace
+
+BENCHMARK(compare_frames<compare_row>)
+    ->ArgNames({"width", "height", "changed"})
+    ->ArgsProduct({{200}, {60}, {0, 1}})
+    ->ArgsProduct({{400}, {120}, {0, 1}});
+
+BENCHMARK(compare_frames<compare_row_scalar>)
+    ->ArgNames({"width", "height", "changed"})
+    ->ArgsProduct({{200}, {60}, {0, 1}})
+    ->ArgsProduct({{400}, {120}, {0, 1}});
+
+BENCHMARK(encode_frames)
+    ->ArgNames({"width", "height"})
+    ->Args({200, 60})
+    ->Args({400, 120});
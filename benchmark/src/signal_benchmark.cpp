@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+#include <boost/signals2/signal.hpp>
+#include <munin/detail/single_threaded_signal.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Every allocation in the benchmark is counted, so that the memory that
+// each kind of signal costs can be reported alongside its speed.
+namespace {
+
+std::atomic<std::size_t> allocated_bytes{0};
+
+}  // namespace
+
+void *operator new(std::size_t size)
+{
+    allocated_bytes += size;
+
+    if (auto *ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr)
+    {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace {
+
+using boost_signal = boost::signals2::signal<void()>;
+using single_threaded_signal = munin::detail::single_threaded_signal<void()>;
+
+// ==========================================================================
+// SIGNAL_MEMORY
+// ==========================================================================
+// Constructs a batch of signals, as a tree of components would, and
+// connects the given number of slots to each.  Reports the number of bytes
+// allocated per signal, not including the signal object itself, which is
+// reported separately.
+template <class Signal>
+void signal_memory(benchmark::State &state)
+{
+    constexpr std::size_t signal_count = 1000;
+    auto const slot_count = state.range(0);
+    std::size_t bytes_per_signal = 0;
+
+    for (auto _ : state)
+    {
+        auto const bytes_before = allocated_bytes.load();
+
+        auto signals = std::make_unique<Signal[]>(signal_count);
+
+        for (std::size_t index = 0; index < signal_count; ++index)
+        {
+            for (auto slot = 0; slot < slot_count; ++slot)
+            {
+                signals[index].connect([] {});
+            }
+        }
+
+        bytes_per_signal =
+            (allocated_bytes.load() - bytes_before
+             - sizeof(Signal) * signal_count)
+            / signal_count;
+
+        benchmark::DoNotOptimize(signals.get());
+    }
+
+    state.counters["signal_size"] = static_cast<double>(sizeof(Signal));
+    state.counters["allocated_per_signal"] =
+        static_cast<double>(bytes_per_signal);
+}
+
+// ==========================================================================
+// SIGNAL_EMIT
+// ==========================================================================
+// Emits a signal with the given number of slots, as happens for each
+// keystroke or redraw at every level of the component tree.
+template <class Signal>
+void signal_emit(benchmark::State &state)
+{
+    Signal sig;
+    int calls = 0;
+
+    for (auto slot = 0; slot < state.range(0); ++slot)
+    {
+        sig.connect([&calls] { ++calls; });
+    }
+
+    for (auto _ : state)
+    {
+        sig();
+    }
+
+    benchmark::DoNotOptimize(calls);
+}
+
+// ==========================================================================
+// SIGNAL_CONNECT_DISCONNECT
+// ==========================================================================
+// Connects and disconnects a slot, as happens for each signal of each
+// component that is added to and removed from a container.
+template <class Signal>
+void signal_connect_disconnect(benchmark::State &state)
+{
+    Signal sig;
+
+    for (auto _ : state)
+    {
+        auto const cnx = sig.connect([] {});
+        cnx.disconnect();
+    }
+}
+
+}  // namespace
+
+BENCHMARK(signal_memory<boost_signal>)
+    ->ArgName("slots")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(3);
+BENCHMARK(signal_memory<single_threaded_signal>)
+    ->ArgName("slots")
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(3);
+
+BENCHMARK(signal_emit<boost_signal>)->ArgName("slots")->Arg(1)->Arg(3);
+BENCHMARK(signal_emit<single_threaded_signal>)
+    ->ArgName("slots")
+    ->Arg(1)
+    ->Arg(3);
+
+BENCHMARK(signal_connect_disconnect<boost_signal>);
+BENCHMARK(signal_connect_disconnect<single_threaded_signal>);
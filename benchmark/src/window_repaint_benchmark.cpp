@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+#include <munin/filled_box.hpp>
+#include <munin/window.hpp>
+#include <terminalpp/canvas.hpp>
+#include <terminalpp/terminal.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+
+namespace {
+
+// A channel that discards everything written to it, so that only the cost
+// of working out what to write is measured.
+struct null_channel
+{
+    void async_read(std::function<void(terminalpp::bytes)> const &)
+    {
+    }
+
+    void write(terminalpp::bytes)
+    {
+    }
+
+    [[nodiscard]] bool is_alive() const
+    {
+        return true;
+    }
+
+    void close()
+    {
+    }
+};
+
+// ==========================================================================
+// REPAINT_WINDOW
+// ==========================================================================
+// Repaints a window whose entire content is damaged each time, and reports
+// the rate at which cells were repainted.  The content is either redrawn
+// identically or with every cell changed.  Repainting the same canvas each
+// time lets the window compare only the cells that drawing changed, while
+// alternating between two canvases forces it to compare every damaged
+// cell against the last frame.
+void repaint_window(benchmark::State &state)
+{
+    auto const size = terminalpp::extent{
+        static_cast<terminalpp::coordinate_type>(state.range(0)),
+        static_cast<terminalpp::coordinate_type>(state.range(1))};
+    bool const has_changes = state.range(2) != 0;
+    auto const canvas_count = static_cast<std::size_t>(state.range(3));
+
+    terminalpp::element fill{'x'};
+    auto const content = munin::make_fill(
+        [&fill](munin::render_surface &) { return fill; });
+
+    null_channel channel;
+    terminalpp::terminal terminal{channel};
+    munin::window window{terminal, content};
+
+    std::array<terminalpp::canvas, 2> canvases{
+        terminalpp::canvas{size}, terminalpp::canvas{size}};
+
+    // The first repaint of each canvas paints a full frame, which is not
+    // what is being measured.
+    for (auto &cvs : canvases)
+    {
+        window.repaint(cvs);
+    }
+
+    std::size_t iteration = 0;
+
+    for (auto _ : state)
+    {
+        if (has_changes)
+        {
+            fill.glyph_.character_ = fill.glyph_.character_ == 'x' ? 'y' : 'x';
+        }
+
+        content->on_redraw({
+            {{}, size}
+        });
+        window.repaint(canvases[iteration++ % canvas_count]);
+    }
+
+    state.counters["cells"] = benchmark::Counter(
+        static_cast<double>(size.width_ * size.height_),
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+}  // namespace
+
+BENCHMARK(repaint_window)
+    ->ArgNames({"width", "height", "changed", "canvases"})
+    ->ArgsProduct({{200}, {60}, {0, 1}, {1, 2}})
+    ->ArgsProduct({{400}, {120}, {0, 1}, {1, 2}});
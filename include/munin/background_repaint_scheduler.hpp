@@ -0,0 +1,47 @@
+#pragma once
+#include "munin/repaint_scheduler.hpp"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A repaint scheduler that starts its frames using a timer on an
+/// asio executor.
+///
+/// As with background_animator, the expected usage is that the executor
+/// is the same one (or a strand of the same one) on which all operations
+/// on the window take place, so that there are no race conditions between
+/// repainting and normal operation.
+//* =========================================================================
+class MUNIN_EXPORT background_repaint_scheduler : public repaint_scheduler
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit background_repaint_scheduler(
+        boost::asio::any_io_executor const &executor);
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~background_repaint_scheduler() override;
+
+private:
+    //* =====================================================================
+    /// \brief Schedules start_frame() to be called at a certain time.
+    //* =====================================================================
+    void reset_timer(
+        std::chrono::steady_clock::time_point execution_time) override;
+
+    //* =====================================================================
+    /// \brief Returns the current time
+    //* =====================================================================
+    [[nodiscard]] std::chrono::steady_clock::time_point do_now() const override;
+
+    boost::asio::steady_timer timer_;
+};
+
+}  // namespace munin
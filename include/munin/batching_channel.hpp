@@ -0,0 +1,104 @@
+#pragma once
+
+#include <terminalpp/core.hpp>
+
+#include <functional>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A channel that passes everything on to another channel, but can
+/// hold back the data written to it and then pass it on in a single write.
+/// \par
+/// A terminal encodes and writes each item that is streamed to it
+/// separately, so painting a frame can cause many small writes to the
+/// underlying channel.  A terminal that writes to this channel, rather
+/// than directly to the underlying one, allows all of the output for a
+/// frame to be written at once, without the terminal losing track of the
+/// cursor and attributes that it has already sent.  See
+/// window::batch_output().
+//* =========================================================================
+template <class Channel>
+class batching_channel
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    /// \param channel The channel to which all operations are passed.
+    //* =====================================================================
+    explicit batching_channel(Channel &channel) : channel_(channel)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Asynchronously read from the underlying channel.
+    //* =====================================================================
+    void async_read(std::function<void(terminalpp::bytes)> const &callback)
+    {
+        channel_.async_read(callback);
+    }
+
+    //* =====================================================================
+    /// \brief Write the given data to the underlying channel or, if a batch
+    /// has been begun, add it to the batch.
+    //* =====================================================================
+    void write(terminalpp::bytes data)
+    {
+        if (batching_)
+        {
+            batch_.append(data.begin(), data.end());
+        }
+        else
+        {
+            channel_.write(data);
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the underlying channel is alive.
+    //* =====================================================================
+    [[nodiscard]] bool is_alive() const
+    {
+        return channel_.is_alive();
+    }
+
+    //* =====================================================================
+    /// \brief Closes the underlying channel.
+    //* =====================================================================
+    void close()
+    {
+        channel_.close();
+    }
+
+    //* =====================================================================
+    /// \brief Holds back everything that is written from now on until
+    /// end_batch() is called.
+    //* =====================================================================
+    void begin_batch()
+    {
+        batching_ = true;
+    }
+
+    //* =====================================================================
+    /// \brief Writes everything that was held back since begin_batch() was
+    /// called to the underlying channel in a single write, if there is
+    /// anything to write.
+    //* =====================================================================
+    void end_batch()
+    {
+        batching_ = false;
+
+        if (!batch_.empty())
+        {
+            channel_.write(batch_);
+            batch_.clear();
+        }
+    }
+
+private:
+    Channel &channel_;
+    terminalpp::byte_storage batch_;
+    bool batching_ = false;
+};
+
+}  // namespace munin
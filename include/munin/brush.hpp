@@ -66,6 +66,12 @@ protected:
     //* =====================================================================
     [[nodiscard]] terminalpp::extent do_get_preferred_size() const override;
 
+    //* =====================================================================
+    /// \brief Called by is_opaque().  A brush fills its entire bounds, and
+    /// so is opaque, unless its pattern or any line of it is empty.
+    //* =====================================================================
+    [[nodiscard]] bool do_is_opaque() const override;
+
     //* =====================================================================
     /// \brief Called by draw().  Derived classes must override this function
     /// in order to draw onto the passed canvas.  A component must only draw
@@ -85,6 +91,13 @@ protected:
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     std::vector<terminalpp::string> pattern_;
 };
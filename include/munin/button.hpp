@@ -16,7 +16,7 @@ public:
     //* =====================================================================
     explicit button(terminalpp::string text);
 
-    boost::signals2::signal<void()> on_click;
+    munin::signal<void()> on_click;
 
 protected:
     //* =====================================================================
@@ -25,12 +25,31 @@ protected:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Enter and space click
+    /// the button; other keys are ignored.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Pressing the left
+    /// button clicks the button; other events are ignored.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
     //* =====================================================================
     /// \brief Called by to_json().  Derived classes must override this
     /// function in order to add additional data about their implementation
     /// in a custom manner.
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
 };
 
 //* =========================================================================
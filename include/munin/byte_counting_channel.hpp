@@ -0,0 +1,77 @@
+#pragma once
+
+#include <terminalpp/core.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A channel that passes everything on to another channel, but
+/// counts the bytes that are written to it.
+/// \par
+/// A terminal that writes to this channel, rather than directly to the
+/// underlying one, allows the size of its output to be measured without
+/// encoding it a second time.  See window::measure_output().
+//* =========================================================================
+template <class Channel>
+class byte_counting_channel
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    /// \param channel The channel to which all operations are passed.
+    //* =====================================================================
+    explicit byte_counting_channel(Channel &channel) : channel_(channel)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Asynchronously read from the underlying channel.
+    //* =====================================================================
+    void async_read(std::function<void(terminalpp::bytes)> const &callback)
+    {
+        channel_.async_read(callback);
+    }
+
+    //* =====================================================================
+    /// \brief Write the given data to the underlying channel, and count it.
+    //* =====================================================================
+    void write(terminalpp::bytes data)
+    {
+        bytes_written_ += data.size();
+        channel_.write(data);
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the underlying channel is alive.
+    //* =====================================================================
+    [[nodiscard]] bool is_alive() const
+    {
+        return channel_.is_alive();
+    }
+
+    //* =====================================================================
+    /// \brief Closes the underlying channel.
+    //* =====================================================================
+    void close()
+    {
+        channel_.close();
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes written to the channel since it
+    /// was created.
+    //* =====================================================================
+    [[nodiscard]] std::uint64_t bytes_written() const
+    {
+        return bytes_written_;
+    }
+
+private:
+    Channel &channel_;
+    std::uint64_t bytes_written_ = 0;
+};
+
+}  // namespace munin
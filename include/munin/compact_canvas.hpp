@@ -0,0 +1,166 @@
+#pragma once
+
+#include "munin/export.hpp"
+
+#include <terminalpp/canvas.hpp>
+#include <terminalpp/element.hpp>
+#include <terminalpp/extent.hpp>
+#include <terminalpp/point.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A canvas that stores each of its cells in eight bytes.
+/// \par
+/// A terminalpp::canvas stores a complete element for every cell.  Since a
+/// screen typically uses only a handful of distinct attributes, and almost
+/// entirely single-byte glyphs, a compact_canvas instead stores each cell
+/// as a pair of 32-bit values: the glyph itself if it is a single-byte
+/// glyph (or an index into a table of glyphs otherwise), and an index into
+/// a palette of attributes.
+/// \par
+/// The glyph table and palette belong to the canvas, and are indexed by
+/// hash so that encoding a cell does not depend on the size of either.
+/// They grow as new glyphs and attributes are stored, are reset when the
+/// canvas is assigned from a terminalpp::canvas, and can be compacted to
+/// drop entries that no cell uses any more.
+/// \par
+/// Elements are converted to and from terminalpp::elements on access, so
+/// a compact_canvas is not intended to be drawn on directly.  Rather, it
+/// is a cheap way of holding on to a frame for a long period, such as the
+/// frame that was last painted to a terminal.
+//* =========================================================================
+class MUNIN_EXPORT compact_canvas
+{
+public:
+    //* =====================================================================
+    /// \brief The representation of a single cell in the canvas.
+    //* =====================================================================
+    struct cell
+    {
+        std::uint32_t glyph_;
+        std::uint32_t attribute_;
+
+        bool operator==(cell const &rhs) const = default;
+    };
+
+    //* =====================================================================
+    /// \brief Constructs a canvas of the given size, with every cell set
+    /// to a default element.
+    //* =====================================================================
+    explicit compact_canvas(terminalpp::extent size = {});
+
+    //* =====================================================================
+    /// \brief Constructs a canvas with the same size and content as the
+    /// given terminalpp::canvas.
+    //* =====================================================================
+    explicit compact_canvas(terminalpp::canvas const &cvs);
+
+    //* =====================================================================
+    /// \brief Returns the size of the canvas.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::extent size() const;
+
+    //* =====================================================================
+    /// \brief Returns the element at the given position.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::element get(
+        terminalpp::point const &position) const;
+
+    //* =====================================================================
+    /// \brief Sets the element at the given position.
+    //* =====================================================================
+    void set(
+        terminalpp::point const &position, terminalpp::element const &elem);
+
+    //* =====================================================================
+    /// \brief Sets the element at the given position if it differs from
+    /// the element that is already there.  Returns true if the element
+    /// was changed.
+    //* =====================================================================
+    bool update(
+        terminalpp::point const &position, terminalpp::element const &elem);
+
+    //* =====================================================================
+    /// \brief Returns the cells of the given row.
+    //* =====================================================================
+    [[nodiscard]] std::span<cell const> row(
+        terminalpp::coordinate_type row) const;
+
+    //* =====================================================================
+    /// \brief Converts a run of elements into the cells that would be used
+    /// to store them in this canvas, adding any new glyphs or attributes
+    /// to the canvas's tables as necessary.  The output must be at least
+    /// as long as the input.
+    //* =====================================================================
+    void encode(
+        std::span<terminalpp::element const> elements, std::span<cell> cells);
+
+    //* =====================================================================
+    /// \brief Stores a run of cells that were produced by encode() into a
+    /// row of the canvas, beginning at origin.
+    //* =====================================================================
+    void store(terminalpp::point const &origin, std::span<cell const> cells);
+
+    //* =====================================================================
+    /// \brief Replaces the size and content of the canvas with that of the
+    /// given terminalpp::canvas.
+    //* =====================================================================
+    void assign(terminalpp::canvas const &cvs);
+
+    //* =====================================================================
+    /// \brief Removes glyphs and attributes that are no longer used by any
+    /// cell from the tables, if the tables have at least doubled in size
+    /// since they were last compacted.  This invalidates any cells that
+    /// were produced by encode() but have not yet been stored.
+    //* =====================================================================
+    void compact();
+
+    //* =====================================================================
+    /// \brief Returns a terminalpp::canvas with the same size and content
+    /// as this canvas.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::canvas to_canvas() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of distinct attributes in the palette.
+    //* =====================================================================
+    [[nodiscard]] std::size_t palette_size() const;
+
+    //* =====================================================================
+    /// \brief Returns the number of glyphs that are stored in the glyph
+    /// table rather than directly in the cells.
+    //* =====================================================================
+    [[nodiscard]] std::size_t glyph_table_size() const;
+
+    //* =====================================================================
+    /// \brief Returns an estimate of the memory allocated by the canvas:
+    /// its cells, its glyph table and palette, and the hash indexes of
+    /// both.
+    //* =====================================================================
+    [[nodiscard]] std::size_t heap_bytes() const;
+
+private:
+    [[nodiscard]] std::size_t index_of(terminalpp::point const &position) const;
+    void reset_tables();
+    [[nodiscard]] cell encode(terminalpp::element const &elem);
+    [[nodiscard]] terminalpp::element decode(cell const &cel) const;
+
+    terminalpp::extent size_;
+    std::vector<cell> cells_;
+    std::vector<terminalpp::glyph> glyphs_;
+    std::vector<terminalpp::attribute> attributes_;
+    std::unordered_map<terminalpp::glyph, std::uint32_t> glyph_indices_;
+    std::unordered_map<terminalpp::attribute, std::uint32_t>
+        attribute_indices_;
+    std::uint32_t last_attribute_{0};
+    std::size_t compacted_table_size_{0};
+};
+
+}  // namespace munin
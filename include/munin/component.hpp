@@ -1,20 +1,39 @@
 #pragma once
 
 #include "munin/export.hpp"
+#include "munin/signal.hpp"
 
-#include <boost/signals2/signal.hpp>
 #include <nlohmann/json.hpp>
 #include <terminalpp/extent.hpp>
+#include <terminalpp/mouse.hpp>
 #include <terminalpp/point.hpp>
 #include <terminalpp/rectangle.hpp>
+#include <terminalpp/virtual_key.hpp>
 
 #include <any>
 #include <vector>
 
 namespace munin {
 
+class component_census;
 class render_surface;
 
+//* =========================================================================
+/// \brief A flag that a component raises whenever its position or size is
+/// changed.
+/// \par
+/// A component keeps the flags that watch it in a list that runs through
+/// the flags themselves, so that watching a component costs a pointer in
+/// the component and a node in the watcher, rather than a signal and a
+/// connection.  Containers use these to learn that a subcomponent has been
+/// moved or resized by something other than their layout.
+//* =========================================================================
+struct geometry_watch
+{
+    bool *changed_ = nullptr;
+    geometry_watch *next_ = nullptr;
+};
+
 //* =========================================================================
 /// \brief An object capable of being drawn on a canvas.
 /// \par
@@ -33,7 +52,7 @@ public:
     /// \brief Sets the position of this component.  This does not cause a
     /// redraw, on the basis that the entity performing the move (usually
     /// a layout manager) knows about it, and is better informed about all
-    /// regions redrawn.
+    /// regions redrawn.  If the position is unchanged, this does nothing.
     //* =====================================================================
     void set_position(terminalpp::point const &position);
 
@@ -47,10 +66,23 @@ public:
     /// redraw, on the basis that the entity performing the resize (usually
     /// a layout manager) knows about it, and is better informed about all
     /// regions redrawn.  It does, however, inform an active layout to lay
-    /// the components out.
+    /// the components out.  If the size is unchanged, this does nothing, and
+    /// so nothing within the component is laid out again.
     //* =====================================================================
     void set_size(terminalpp::extent const &size);
 
+    //* =====================================================================
+    /// \brief Adds a watch whose flag is set to true whenever the position
+    /// or size of this component changes.  The watch must be removed with
+    /// unwatch_geometry() before either it or this component is destroyed.
+    //* =====================================================================
+    void watch_geometry(geometry_watch &watch);
+
+    //* =====================================================================
+    /// \brief Removes a watch that was added with watch_geometry().
+    //* =====================================================================
+    void unwatch_geometry(geometry_watch &watch);
+
     //* =====================================================================
     /// \brief Retrieves the size of this component.
     //* =====================================================================
@@ -117,6 +149,13 @@ public:
     //* =====================================================================
     void set_cursor_position(terminalpp::point const &position);
 
+    //* =====================================================================
+    /// \brief Returns true if drawing the component is guaranteed to
+    /// overwrite every cell within its bounds.  Containers use this to avoid
+    /// drawing components that are hidden behind opaque components.
+    //* =====================================================================
+    [[nodiscard]] bool is_opaque() const;
+
     //* =====================================================================
     /// \brief Draws the component.
     ///
@@ -147,18 +186,38 @@ public:
     //* =====================================================================
     void event(std::any const &event);
 
+    //* =====================================================================
+    /// \brief Send a keypress to the component.  This has the same effect
+    /// as sending the keypress as an event of any type, but allows it to be
+    /// handled without being boxed into a std::any.
+    //* =====================================================================
+    void event(terminalpp::virtual_key const &event);
+
+    //* =====================================================================
+    /// \brief Send a mouse event to the component.  This has the same
+    /// effect as sending the mouse event as an event of any type, but
+    /// allows it to be handled without being boxed into a std::any.
+    //* =====================================================================
+    void event(terminalpp::mouse::event const &event);
+
     //* =====================================================================
     /// \brief Returns details about the component in JSON format.
     //* =====================================================================
     [[nodiscard]] nlohmann::json to_json() const;
 
+    //* =====================================================================
+    /// \brief Adds this component, and the components and layouts of which
+    /// it is composed, to the census.
+    //* =====================================================================
+    void census(component_census &cen) const;
+
     //* =====================================================================
     /// \fn on_redraw
     /// \param regions The regions of the component that requires redrawing.
     /// \brief Connect to this signal in order to receive notifications about
     /// when the component should be redrawn.
     //* =====================================================================
-    boost::signals2::signal<void(
+    munin::signal<void(
         std::vector<terminalpp::rectangle> const &regions)>
         on_redraw;
 
@@ -168,35 +227,35 @@ public:
     /// such as text controls that grow with the text within them.  Connect
     /// to this signal in order to receive notifications about this.
     //* =====================================================================
-    boost::signals2::signal<void()> on_preferred_size_changed;
+    munin::signal<void()> on_preferred_size_changed;
 
     //* =====================================================================
     /// \fn on_focus_set
     /// \brief Connect to this signal in order to receive notifications about
     /// when the component has gained focus.
     //* =====================================================================
-    boost::signals2::signal<void()> on_focus_set;
+    munin::signal<void()> on_focus_set;
 
     //* =====================================================================
     /// \fn on_focus_lost
     /// \brief Connect to this signal in order to receive notifications about
     /// when the component has lost focus.
     //* =====================================================================
-    boost::signals2::signal<void()> on_focus_lost;
+    munin::signal<void()> on_focus_lost;
 
     //* =====================================================================
     /// \fn on_cursor_state_changed
     /// \brief Connect to this signal in order to receive notifications about
     /// when the component's cursor state changes.
     //* =====================================================================
-    boost::signals2::signal<void()> on_cursor_state_changed;
+    munin::signal<void()> on_cursor_state_changed;
 
     //* =====================================================================
     /// \fn on_cursor_position_changed
     /// \brief Connect to this signal in order to receive notifications about
     /// when the component's cursor position changes.
     //* =====================================================================
-    boost::signals2::signal<void()> on_cursor_position_changed;
+    munin::signal<void()> on_cursor_position_changed;
 
 protected:
     //* =====================================================================
@@ -292,6 +351,13 @@ protected:
     //* =====================================================================
     virtual void do_set_cursor_position(terminalpp::point const &position) = 0;
 
+    //* =====================================================================
+    /// \brief Called by is_opaque().  Derived classes may override this
+    /// function in order to declare that they always draw over every cell
+    /// within their bounds.  By default, components are not opaque.
+    //* =====================================================================
+    [[nodiscard]] virtual bool do_is_opaque() const;
+
     //* =====================================================================
     /// \brief Called by draw().  Derived classes must override this function
     /// in order to draw onto the passed context.  A component must only draw
@@ -310,12 +376,46 @@ protected:
     //* =====================================================================
     virtual void do_event(std::any const &event) = 0;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Derived classes may
+    /// override this function in order to handle keypresses without
+    /// unboxing them.  By default, the keypress is passed to do_event().
+    /// A derived class that handles keypresses in do_event() and overrides
+    /// this function must handle them the same way in both.
+    //* =====================================================================
+    virtual void do_key_event(terminalpp::virtual_key const &event);
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Derived classes may
+    /// override this function in order to handle mouse events without
+    /// unboxing them.  By default, the event is passed to do_event().
+    /// A derived class that handles mouse events in do_event() and
+    /// overrides this function must handle them the same way in both.
+    //* =====================================================================
+    virtual void do_mouse_event(terminalpp::mouse::event const &event);
+
     //* =====================================================================
     /// \brief Called by to_json().  Derived classes must override this
     /// function in order to add additional data about their implementation
     /// in a custom manner.
     //* =====================================================================
     [[nodiscard]] virtual nlohmann::json do_to_json() const = 0;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    /// An override must also call the function that it overrides.
+    //* =====================================================================
+    virtual void do_census(component_census &cen) const;
+
+private:
+    //* =====================================================================
+    /// \brief Sets the flag of every watch on this component's geometry.
+    //* =====================================================================
+    void raise_geometry_watches();
+
+    geometry_watch *geometry_watches_ = nullptr;
 };
 
 }  // namespace munin
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "munin/export.hpp"
+#include "munin/signal.hpp"
+
+#include <nlohmann/json.hpp>
+#include <terminalpp/string.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A count, by type, of the objects that make up a tree of
+/// components, of the memory that they use, and of the slots that are
+/// connected to their signals.
+/// \par
+/// Components add themselves to a census with component::census(), which
+/// also adds the components and layouts of which they are composed.
+/// \par
+/// The heap bytes of an object are an estimate of the memory that it has
+/// allocated for itself: its implementation, any strings and other
+/// collections that it holds, and the storage for its signals and their
+/// slots.  The object itself is not included, since only the code that
+/// created it knows how it was allocated.  The storage for signals is
+/// itself an estimate; see estimate_signal_bytes().
+//* =========================================================================
+class MUNIN_EXPORT component_census
+{
+public:
+    //* =====================================================================
+    /// \brief The figures for one type of object, or for all objects.
+    //* =====================================================================
+    struct entry
+    {
+        std::size_t instances = 0;
+        std::size_t heap_bytes = 0;
+        std::size_t connections = 0;
+
+        bool operator==(entry const &rhs) const = default;
+    };
+
+    //* =====================================================================
+    /// \brief Counts an instance of the given type.
+    //* =====================================================================
+    void add_instance(std::type_info const &type);
+
+    //* =====================================================================
+    /// \brief Adds an estimate of memory allocated by an object of the
+    /// given type.
+    //* =====================================================================
+    void add_heap_bytes(std::type_info const &type, std::size_t bytes);
+
+    //* =====================================================================
+    /// \brief Adds the connections to a signal belonging to an object of
+    /// the given type, and an estimate of the memory that the signal uses.
+    //* =====================================================================
+    template <class Signature>
+    void add_signal(
+        std::type_info const &type, munin::signal<Signature> const &sig)
+    {
+        auto const slots = sig.num_slots();
+        add(type, entry{0, estimate_signal_bytes(slots), slots});
+    }
+
+    //* =====================================================================
+    /// \brief Returns the figures for each type of object, keyed by the
+    /// name of the type.
+    //* =====================================================================
+    [[nodiscard]] std::map<std::string, entry> const &types() const;
+
+    //* =====================================================================
+    /// \brief Returns the figures for all objects together.
+    //* =====================================================================
+    [[nodiscard]] entry const &totals() const;
+
+    //* =====================================================================
+    /// \brief Returns the census in JSON format.
+    //* =====================================================================
+    [[nodiscard]] nlohmann::json to_json() const;
+
+    //* =====================================================================
+    /// \brief Returns an estimate of the memory used by a signal with the
+    /// given number of connected slots.  For single-threaded signals, this
+    /// is derived from the sizes of their parts.  For boost::signals2, it
+    /// is based on figures measured on one platform, and so is only a
+    /// rough guide elsewhere.
+    //* =====================================================================
+    [[nodiscard]] static std::size_t estimate_signal_bytes(std::size_t slots);
+
+    //* =====================================================================
+    /// \brief Returns an estimate of the memory used by the elements of a
+    /// string.
+    //* =====================================================================
+    [[nodiscard]] static std::size_t estimate_string_bytes(
+        terminalpp::string const &str);
+
+    //* =====================================================================
+    /// \brief Returns an estimate of the memory used by a collection of
+    /// strings, including the elements of each string.
+    //* =====================================================================
+    [[nodiscard]] static std::size_t estimate_string_bytes(
+        std::vector<terminalpp::string> const &strs);
+
+private:
+    void add(std::type_info const &type, entry const &ent);
+
+    std::map<std::string, entry> types_;
+    entry totals_;
+};
+
+}  // namespace munin
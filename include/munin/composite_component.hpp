@@ -37,6 +37,20 @@ protected:
         std::shared_ptr<component> const &comp,
         std::any const &hint = std::any());
 
+    //* =====================================================================
+    /// \brief Passes a keypress to the underlying container without boxing
+    /// it.  By default, keypresses are passed to do_event(); a derived
+    /// class may override do_key_event() to call this instead.
+    //* =====================================================================
+    void forward_event(terminalpp::virtual_key const &event);
+
+    //* =====================================================================
+    /// \brief Passes a mouse event to the underlying container without
+    /// boxing it.  By default, mouse events are passed to do_event(); a
+    /// derived class may override do_mouse_event() to call this instead.
+    //* =====================================================================
+    void forward_event(terminalpp::mouse::event const &event);
+
     //* =====================================================================
     /// \brief Called by set_position().  Derived classes must override this
     /// function in order to set the position of the component in a custom
@@ -150,6 +164,13 @@ protected:
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     munin::container content_;
 };
@@ -3,6 +3,7 @@
 #include <boost/asio.hpp>
 #include <munin/window.hpp>
 
+#include <chrono>
 #include <memory>
 
 namespace munin {
@@ -28,6 +29,11 @@ namespace munin {
 /// io_context.run(); // Application is now running.
 /// \endcode
 ///
+/// \par
+/// Repaints are paced by a background_repaint_scheduler running on the
+/// io_context, so that any number of changes to the user interface within
+/// a frame interval result in a single repaint.
+///
 //* =========================================================================
 class MUNIN_EXPORT console_application
 {
@@ -45,6 +51,11 @@ public:
     //* =====================================================================
     terminalpp::terminal &terminal();
 
+    //* =====================================================================
+    /// \brief Sets the minimum time between two repaints of the window.
+    //* =====================================================================
+    void set_frame_interval(std::chrono::steady_clock::duration interval);
+
     //* =====================================================================
     /// \brief Destructor
     //* =====================================================================
@@ -11,6 +11,23 @@ class layout;
 //* =========================================================================
 /// \brief A graphical element capable of containing and arranging other
 /// subcomponents.
+/// \par
+/// Containers with many subcomponents keep a spatial index of their
+/// subcomponents' bounds so that drawing and mouse hit-testing do not need
+/// to examine every subcomponent.  The index is refreshed whenever a
+/// subcomponent is added, removed, moved or resized, whether or not by the
+/// container's layout.
+/// \par
+/// A container is laid out whenever its layout, subcomponents or size
+/// change.  While a redraw_transaction is open, this is postponed until
+/// the transaction closes, or until the container is next drawn or
+/// receives a mouse event, so that many changes cost only one layout.
+/// \par
+/// A container's preferred size is remembered between calls, and is only
+/// recalculated after its layout or subcomponents change, or after one of
+/// its subcomponents announces that its own preferred size has changed.
+/// Such announcements are passed on as changes to the preferred size of
+/// the container.
 //* =========================================================================
 class MUNIN_EXPORT container final : public component
 {
@@ -41,10 +58,30 @@ public:
         std::any const &layout_hint = std::any());
 
     //* =====================================================================
-    /// \brief Removes a component from the container.
+    /// \brief Removes a component from the container.  If the component is
+    /// not in the container, this does nothing.
+    /// \par
+    /// The component is found without searching the container.  However,
+    /// the container is then laid out again, which takes time in proportion
+    /// to the number of components.  Only within a redraw_transaction is
+    /// this postponed, so that removing several components in a transaction
+    /// costs only one layout, and each removal takes constant time.
     //* =====================================================================
     void remove_component(std::shared_ptr<component> const &component);
 
+    //* =====================================================================
+    /// \brief Replaces all of the container's components with the given
+    /// components.  The container is laid out and announces a change in its
+    /// preferred size once, rather than once per component.
+    /// \param components The new components of the container
+    /// \param layout_hints Hints to be passed to the container's current
+    ///        layout, one per component.  If empty, then no component has a
+    ///        hint.
+    //* =====================================================================
+    void replace_components(
+        std::vector<std::shared_ptr<component>> const &components,
+        std::vector<std::any> const &layout_hints = {});
+
 private:
     //* =====================================================================
     /// \brief Called by set_position().  Derived classes must override this
@@ -120,6 +157,18 @@ private:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  The keypress is passed on
+    /// to the subcomponent with focus.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  The event is passed on
+    /// to the subcomponent at its location.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
     //* =====================================================================
     /// \brief Called by get_cursor_state().  Derived classes must override
     /// this function in order to return the cursor state in a custom manner.
@@ -159,6 +208,13 @@ private:
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
     struct impl;
     std::unique_ptr<impl> pimpl_;
 };
@@ -3,14 +3,20 @@
 #include "munin/export.hpp"
 
 #include <terminalpp/rectangle.hpp>
+#include <terminalpp/string.hpp>
 
 #include <optional>
+#include <span>
 
 namespace terminalpp {
 class canvas;
 class canvas_view;
 }  // namespace terminalpp
 
+namespace munin {
+class render_surface;
+}  // namespace munin
+
 namespace munin::detail {
 
 //* =========================================================================
@@ -20,4 +26,34 @@ MUNIN_EXPORT
 std::optional<terminalpp::rectangle> intersection(
     terminalpp::rectangle const &lhs, terminalpp::rectangle const &rhs);
 
+//* =========================================================================
+/// \brief Copies a line of text into a row of elements, where the first
+/// element of the row corresponds to the given column of the text.  Any
+/// elements of the row that do not correspond to a column of the text
+/// (including those before the start of the text if the column is
+/// negative) are set to the fill element.
+//* =========================================================================
+MUNIN_EXPORT
+void copy_line(
+    std::span<terminalpp::element> row,
+    terminalpp::string const &text,
+    terminalpp::coordinate_type column,
+    terminalpp::element const &fill);
+
+//* =========================================================================
+/// \brief As above, but copies the line of text into a row of a surface,
+/// beginning at origin and extending for length elements.  A length of
+/// zero or less writes nothing.  Elements are written using the surface's
+/// bulk operations, so that elements that are unchanged are not recorded
+/// as such.
+//* =========================================================================
+MUNIN_EXPORT
+void copy_line(
+    render_surface &surface,
+    terminalpp::point origin,
+    terminalpp::coordinate_type length,
+    terminalpp::string const &text,
+    terminalpp::coordinate_type column,
+    terminalpp::element const &fill);
+
 }  // namespace munin::detail
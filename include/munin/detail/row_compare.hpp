@@ -0,0 +1,48 @@
+#pragma once
+
+#include "munin/compact_canvas.hpp"
+#include "munin/export.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+
+namespace munin::detail {
+
+//* =========================================================================
+/// \brief The range of columns within a row that contains every cell that
+/// differs between two frames, from first_ up to but not including last_.
+//* =========================================================================
+struct row_difference
+{
+    std::size_t first_;
+    std::size_t last_;
+
+    bool operator==(row_difference const &rhs) const = default;
+};
+
+//* =========================================================================
+/// \brief Compares two rows of cells of the same length, and returns the
+/// range of columns in which they differ, or std::nullopt if they are
+/// identical.
+/// \par
+/// On x86 processors, SSE2 or AVX2 instructions are used to compare
+/// several cells at once.  When built with GCC or Clang, AVX2 is used if
+/// the processor supports it, whatever the target the library was compiled
+/// for.  Other compilers only use AVX2 if the library is compiled for a
+/// target that has it (e.g. /arch:AVX2).
+//* =========================================================================
+MUNIN_EXPORT
+std::optional<row_difference> compare_row(
+    std::span<compact_canvas::cell const> lhs,
+    std::span<compact_canvas::cell const> rhs);
+
+//* =========================================================================
+/// \brief As compare_row, but always comparing one cell at a time.
+//* =========================================================================
+MUNIN_EXPORT
+std::optional<row_difference> compare_row_scalar(
+    std::span<compact_canvas::cell const> lhs,
+    std::span<compact_canvas::cell const> rhs);
+
+}  // namespace munin::detail
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace munin::detail {
+
+//* =========================================================================
+/// \brief The part of a single-threaded signal that a connection refers
+/// to, independent of the signature of the signal.
+//* =========================================================================
+class single_threaded_signal_body_base
+{
+public:
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    virtual ~single_threaded_signal_body_base() = default;
+
+    //* =====================================================================
+    /// \brief Disconnects the slot with the given identifier, if it is
+    /// still connected.
+    //* =====================================================================
+    virtual void disconnect(std::uint64_t id) = 0;
+
+    //* =====================================================================
+    /// \brief Returns whether the slot with the given identifier is still
+    /// connected.
+    //* =====================================================================
+    [[nodiscard]] virtual bool connected(std::uint64_t id) const = 0;
+};
+
+//* =========================================================================
+/// \brief A handle to a slot connected to a single-threaded signal, with
+/// which it can be disconnected.  A connection may safely outlive both the
+/// slot and the signal.
+//* =========================================================================
+class single_threaded_connection
+{
+public:
+    //* =====================================================================
+    /// \brief Constructs a connection that refers to no slot.
+    //* =====================================================================
+    single_threaded_connection() = default;
+
+    //* =====================================================================
+    /// \brief Constructs a connection to the slot with the given identifier
+    /// in the given signal.
+    //* =====================================================================
+    single_threaded_connection(
+        std::weak_ptr<single_threaded_signal_body_base> body, std::uint64_t id)
+      : body_(std::move(body)), id_(id)
+    {
+    }
+
+    //* =====================================================================
+    /// \brief Disconnects the slot from the signal.  If the signal is
+    /// being emitted, the slot will not be called again, even if it has not
+    /// yet been called during this emission.
+    //* =====================================================================
+    void disconnect() const
+    {
+        if (auto const body = body_.lock(); body)
+        {
+            body->disconnect(id_);
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the slot is still connected to the signal.
+    //* =====================================================================
+    [[nodiscard]] bool connected() const
+    {
+        auto const body = body_.lock();
+        return body && body->connected(id_);
+    }
+
+private:
+    std::weak_ptr<single_threaded_signal_body_base> body_;
+    std::uint64_t id_ = 0;
+};
+
+//* =========================================================================
+/// \brief The slots of a single-threaded signal.
+/// \par
+/// Most signals have only one or two slots, and so the first two are held
+/// inline in the body, rather than in a separately allocated list.  Since
+/// the body is allocated together with its reference count, a signal with
+/// one or two slots costs a single allocation.  Slots connected
+/// while the signal is being emitted are held aside until the emission
+/// completes, and so are not called by it.  Slots disconnected while the
+/// signal is being emitted are removed once the emission completes, so
+/// that a slot may safely disconnect itself.
+//* =========================================================================
+template <class... Args>
+class single_threaded_signal_body final
+  : public single_threaded_signal_body_base
+{
+public:
+    using slot_function = std::function<void(Args...)>;
+
+    //* =====================================================================
+    /// \brief Adds a slot to the signal, and returns its identifier.
+    //* =====================================================================
+    std::uint64_t connect(slot_function function)
+    {
+        auto const id = next_id_++;
+
+        if (emitting_ == 0)
+        {
+            slots_.push_back({id, std::move(function)});
+        }
+        else
+        {
+            pending_slots_.push_back({id, std::move(function)});
+        }
+
+        return id;
+    }
+
+    //* =====================================================================
+    /// \brief Disconnects the slot with the given identifier.
+    //* =====================================================================
+    void disconnect(std::uint64_t id) override
+    {
+        auto const has_id = [id](auto const &slt) { return slt.id_ == id; };
+
+        if (auto const slt = std::ranges::find_if(slots_, has_id);
+            slt != slots_.end())
+        {
+            // A slot that is being called must not be destroyed, so during
+            // an emission it is only marked as disconnected.
+            if (emitting_ == 0)
+            {
+                slots_.erase(slt);
+            }
+            else
+            {
+                slt->id_ = 0;
+                has_vacancies_ = true;
+            }
+        }
+        else
+        {
+            std::erase_if(pending_slots_, has_id);
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Disconnects every slot.
+    //* =====================================================================
+    void disconnect_all()
+    {
+        if (emitting_ == 0)
+        {
+            slots_.clear();
+        }
+        else
+        {
+            for (auto &slt : slots_)
+            {
+                slt.id_ = 0;
+            }
+
+            has_vacancies_ = true;
+        }
+
+        pending_slots_.clear();
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the slot with the given identifier is still
+    /// connected.
+    //* =====================================================================
+    [[nodiscard]] bool connected(std::uint64_t id) const override
+    {
+        auto const has_id = [id](auto const &slt) { return slt.id_ == id; };
+
+        return id != 0
+            && (std::ranges::any_of(slots_, has_id)
+                || std::ranges::any_of(pending_slots_, has_id));
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of connected slots.
+    //* =====================================================================
+    [[nodiscard]] std::size_t size() const
+    {
+        auto const is_connected = [](auto const &slt) { return slt.id_ != 0; };
+
+        return static_cast<std::size_t>(
+                   std::ranges::count_if(slots_, is_connected))
+             + pending_slots_.size();
+    }
+
+    //* =====================================================================
+    /// \brief Calls each connected slot in the order that they were
+    /// connected.
+    //* =====================================================================
+    void emit(Args... args)
+    {
+        emission const guard{*this};
+
+        // Slots connected during the emission are held aside, and so the
+        // slots may be iterated by index even if a slot connects another.
+        for (std::size_t index = 0; index < slots_.size(); ++index)
+        {
+            if (slots_[index].id_ != 0)
+            {
+                slots_[index].function_(args...);
+            }
+        }
+    }
+
+private:
+    struct slot
+    {
+        std::uint64_t id_;
+        slot_function function_;
+    };
+
+    // ======================================================================
+    // EMISSION
+    // ======================================================================
+    // Tracks the depth of emission, tidying up any slots that were connected
+    // or disconnected during an emission once the outermost one completes,
+    // even if a slot throws.
+    struct emission
+    {
+        explicit emission(single_threaded_signal_body &body) : body_(body)
+        {
+            ++body_.emitting_;
+        }
+
+        ~emission()
+        {
+            if (--body_.emitting_ == 0)
+            {
+                body_.settle();
+            }
+        }
+
+        emission(emission const &) = delete;
+        emission &operator=(emission const &) = delete;
+
+        single_threaded_signal_body &body_;
+    };
+
+    // ======================================================================
+    // SETTLE
+    // ======================================================================
+    void settle()
+    {
+        if (has_vacancies_)
+        {
+            slots_.erase(
+                std::remove_if(
+                    slots_.begin(),
+                    slots_.end(),
+                    [](auto const &slt) { return slt.id_ == 0; }),
+                slots_.end());
+            has_vacancies_ = false;
+        }
+
+        if (!pending_slots_.empty())
+        {
+            std::ranges::move(pending_slots_, std::back_inserter(slots_));
+            pending_slots_.clear();
+        }
+    }
+
+    boost::container::small_vector<slot, 2> slots_;
+    std::vector<slot> pending_slots_;
+    std::uint64_t next_id_ = 1;
+    int emitting_ = 0;
+    bool has_vacancies_ = false;
+};
+
+template <class Signature>
+class single_threaded_signal;
+
+//* =========================================================================
+/// \brief A signal for use by objects that are only ever used from one
+/// thread at a time.
+/// \par
+/// This has the same semantics as boost::signals2::signal for signals that
+/// return void, including connecting one signal to another, but without
+/// the cost of making it safe to connect, disconnect and emit from several
+/// threads at once.  A signal with no slots allocates nothing, and the
+/// first slot that is connected allocates the body that holds it.  The
+/// body cannot be held within the signal itself, since connections refer
+/// to it and may outlive the signal.
+//* =========================================================================
+template <class... Args>
+class single_threaded_signal<void(Args...)>
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    single_threaded_signal() = default;
+
+    //* =====================================================================
+    /// \brief Destructor.  Disconnects any slots that remain connected.
+    //* =====================================================================
+    ~single_threaded_signal()
+    {
+        disconnect_all_slots();
+    }
+
+    single_threaded_signal(single_threaded_signal const &) = delete;
+    single_threaded_signal &operator=(single_threaded_signal const &) = delete;
+    single_threaded_signal(single_threaded_signal &&) noexcept = default;
+    single_threaded_signal &operator=(single_threaded_signal &&) noexcept =
+        default;
+
+    //* =====================================================================
+    /// \brief Connects a slot to the signal.
+    //* =====================================================================
+    template <class Slot>
+    single_threaded_connection connect(Slot &&slt)
+    {
+        auto &bdy = body();
+        auto const id = bdy.connect(std::forward<Slot>(slt));
+        return {body_, id};
+    }
+
+    //* =====================================================================
+    /// \brief Connects another signal to this one, so that emitting this
+    /// signal emits the other.  If the other signal is destroyed, it is no
+    /// longer emitted.
+    //* =====================================================================
+    single_threaded_connection connect(single_threaded_signal &other)
+    {
+        other.body();
+
+        return connect([weak_other = std::weak_ptr(other.body_)](
+                           Args... args) {
+            if (auto const other_body = weak_other.lock(); other_body)
+            {
+                other_body->emit(args...);
+            }
+        });
+    }
+
+    //* =====================================================================
+    /// \brief Disconnects every slot from the signal.
+    //* =====================================================================
+    void disconnect_all_slots()
+    {
+        if (body_)
+        {
+            body_->disconnect_all();
+        }
+    }
+
+    //* =====================================================================
+    /// \brief Returns whether the signal has no connected slots.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const
+    {
+        return num_slots() == 0;
+    }
+
+    //* =====================================================================
+    /// \brief Returns the number of connected slots.
+    //* =====================================================================
+    [[nodiscard]] std::size_t num_slots() const
+    {
+        return body_ ? body_->size() : 0;
+    }
+
+    //* =====================================================================
+    /// \brief Calls each connected slot with the given arguments.
+    //* =====================================================================
+    void operator()(Args... args) const
+    {
+        // The body is kept alive for the duration of the emission, in case
+        // a slot destroys the object that owns the signal.
+        if (auto const bdy = body_; bdy)
+        {
+            bdy->emit(args...);
+        }
+    }
+
+private:
+    using body_type = single_threaded_signal_body<Args...>;
+
+    body_type &body()
+    {
+        if (!body_)
+        {
+            body_ = std::make_shared<body_type>();
+        }
+
+        return *body_;
+    }
+
+    std::shared_ptr<body_type> body_;
+};
+
+}  // namespace munin::detail
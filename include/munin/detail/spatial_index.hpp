@@ -0,0 +1,60 @@
+#pragma once
+
+#include "munin/export.hpp"
+
+#include <terminalpp/point.hpp>
+#include <terminalpp/rectangle.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace munin::detail {
+
+//* =========================================================================
+/// \brief A uniform grid over a set of rectangles, which allows finding
+/// the rectangles at a point or within a region without examining every
+/// rectangle in the set.
+/// \par
+/// Rectangles are identified by their index in the collection from which
+/// the grid was built, and all queries report indices in ascending order.
+//* =========================================================================
+class MUNIN_EXPORT spatial_index
+{
+public:
+    //* =====================================================================
+    /// \brief Replaces the content of the index with the given rectangles.
+    //* =====================================================================
+    void rebuild(std::vector<terminalpp::rectangle> const &bounds);
+
+    //* =====================================================================
+    /// \brief Returns the indices of the rectangles that intersect the
+    /// given region, in ascending order.
+    //* =====================================================================
+    [[nodiscard]] std::vector<std::size_t> query(
+        terminalpp::rectangle const &region) const;
+
+    //* =====================================================================
+    /// \brief Returns the lowest index of a rectangle that contains the
+    /// given point, if there is one.
+    //* =====================================================================
+    [[nodiscard]] std::optional<std::size_t> find(
+        terminalpp::point const &location) const;
+
+    //* =====================================================================
+    /// \brief Returns the number of bytes that the index has allocated.
+    //* =====================================================================
+    [[nodiscard]] std::size_t heap_bytes() const;
+
+private:
+    [[nodiscard]] std::size_t cell_column(terminalpp::coordinate_type x) const;
+    [[nodiscard]] std::size_t cell_row(terminalpp::coordinate_type y) const;
+
+    std::vector<terminalpp::rectangle> bounds_;
+    terminalpp::rectangle area_;
+    terminalpp::extent cell_size_;
+    std::size_t grid_width_ = 0;
+    std::vector<std::vector<std::size_t>> cells_;
+};
+
+}  // namespace munin::detail
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "munin/export.hpp"
+
+#include <terminalpp/extent.hpp>
+#include <terminalpp/rectangle.hpp>
+
+#include <vector>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A record of which cells of a canvas have changed, kept as the
+/// span of changed columns in each row.
+/// \par
+/// This is filled in by a render_surface that compares elements as they
+/// are written, so that cells that were drawn over with identical content
+/// are not recorded.  Each row records only the leftmost and rightmost
+/// changed columns, so a span may also include unchanged cells between
+/// them.
+//* =========================================================================
+class MUNIN_EXPORT dirty_spans
+{
+public:
+    //* =====================================================================
+    /// \brief Clears all recorded changes, and sets the size of the canvas
+    /// whose changes are to be recorded.
+    //* =====================================================================
+    void reset(terminalpp::extent size);
+
+    //* =====================================================================
+    /// \brief Records that the cells in the given row, from first_column
+    /// up to but not including last_column, have changed.  Cells outside
+    /// of the canvas are ignored.
+    //* =====================================================================
+    void mark(
+        terminalpp::coordinate_type row,
+        terminalpp::coordinate_type first_column,
+        terminalpp::coordinate_type last_column);
+
+    //* =====================================================================
+    /// \brief Returns true if no changes have been recorded.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const;
+
+    //* =====================================================================
+    /// \brief Returns the recorded changes as a set of rectangles, each of
+    /// which is one row high, ordered from top to bottom.
+    //* =====================================================================
+    [[nodiscard]] std::vector<terminalpp::rectangle> rectangles() const;
+
+private:
+    struct span
+    {
+        terminalpp::coordinate_type left_;
+        terminalpp::coordinate_type right_;
+    };
+
+    terminalpp::coordinate_type width_{0};
+    std::vector<span> rows_;
+    bool empty_{true};
+};
+
+}  // namespace munin
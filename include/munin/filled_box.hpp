@@ -50,6 +50,12 @@ protected:
     //* =====================================================================
     [[nodiscard]] terminalpp::extent do_get_preferred_size() const override;
 
+    //* =====================================================================
+    /// \brief Called by is_opaque().  A filled box always fills its entire
+    /// bounds, and so is opaque.
+    //* =====================================================================
+    [[nodiscard]] bool do_is_opaque() const override;
+
     //* =====================================================================
     /// \brief Called by draw().  Derived classes must override this function
     /// in order to draw onto the passed canvas.  A component must only draw
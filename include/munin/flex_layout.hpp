@@ -0,0 +1,125 @@
+#pragma once
+
+#include "munin/layout.hpp"
+
+#include <optional>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A class that knows how to lay components out in a container in
+/// a single row or column, in the manner of a CSS flexbox.
+/// \par
+/// Each component begins with a basis length along the direction of the
+/// layout, which is either given in its hint or is its preferred length.
+/// Any space that remains is shared between the components in proportion
+/// to their grow factors.  If there is not enough space, then the
+/// components are shrunk in proportion to their shrink factors multiplied
+/// by their bases.  A component whose share of the shortfall would be at
+/// least its whole basis is shrunk to nothing instead, and the rest of the
+/// shortfall is shared among the others, so that the components always fit
+/// unless those that do not shrink are too long by themselves.  In the
+/// other direction, each component fills the container.
+/// \par
+/// This means that a screen that would otherwise be built from several
+/// levels of compass, grid and strip layouts can often be expressed with
+/// a single container.  For example, a column with a fixed header and
+/// footer and a body that takes all of the remaining space:
+///
+/// \code
+/// auto screen = view(
+///     make_flex_layout(flex_layout::direction::column),
+///     header, flex_layout::hint{},
+///     body,   flex_layout::hint{.grow = 1},
+///     footer, flex_layout::hint{});
+/// \endcode
+///
+/// Components without a flex_layout::hint behave as if given a default
+/// hint.  Laying out takes a single pass over the components, except that
+/// if there is not enough space, the components that shrink are also
+/// sorted by their shrink factors in order to find those that are shrunk to
+/// nothing.
+//* =========================================================================
+class MUNIN_EXPORT flex_layout final : public layout
+{
+public:
+    //* =====================================================================
+    /// \brief An enumeration of the directions in which components can be
+    /// laid out.
+    //* =====================================================================
+    enum class direction
+    {
+        row,
+        column
+    };
+
+    //* =====================================================================
+    /// \brief A hint for a flex_layout about how to size a component.
+    //* =====================================================================
+    struct hint
+    {
+        //* =================================================================
+        /// \brief The share of any remaining space that the component is
+        /// given.  A component with a grow factor of zero does not grow.
+        //* =================================================================
+        int grow = 0;
+
+        //* =================================================================
+        /// \brief The share of any shortfall of space that the component
+        /// gives up.  A component with a shrink factor of zero does not
+        /// shrink.
+        //* =================================================================
+        int shrink = 1;
+
+        //* =================================================================
+        /// \brief The length of the component before it grows or shrinks.
+        /// If this is not set, then the component's preferred length is
+        /// used.
+        //* =================================================================
+        std::optional<terminalpp::coordinate_type> basis = std::nullopt;
+    };
+
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit flex_layout(direction dir = direction::row);
+
+protected:
+    //* =====================================================================
+    /// \brief Called by get_preferred_size().  Derived classes must override
+    /// this function in order to retrieve the preferred size of the layout
+    /// in a custom manner.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::extent do_get_preferred_size(
+        std::vector<std::shared_ptr<component>> const &components,
+        std::vector<std::any> const &hints) const override;
+
+    //* =====================================================================
+    /// \brief Called by operator().  Derived classes must override this
+    /// function in order to lay a container's components out in a custom
+    /// manner.
+    //* =====================================================================
+    void do_layout(
+        std::vector<std::shared_ptr<component>> const &components,
+        std::vector<std::any> const &hints,
+        terminalpp::extent size) const override;
+
+    //* =====================================================================
+    /// \brief Called by to_json().  Derived classes must override this
+    /// function in order to add additional data about their implementation
+    /// in a custom manner.
+    //* =====================================================================
+    [[nodiscard]] nlohmann::json do_to_json() const override;
+
+private:
+    direction direction_;
+};
+
+//* =========================================================================
+/// \brief Returns a newly created flex layout
+//* =========================================================================
+MUNIN_EXPORT
+std::unique_ptr<layout> make_flex_layout(
+    flex_layout::direction dir = flex_layout::direction::row);
+
+}  // namespace munin
@@ -26,6 +26,19 @@ protected:
     //* =====================================================================
     void do_event(std::any const &ev) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  The keypress is passed
+    /// on to the underlying container unboxed.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  The event is moved into
+    /// the co-ordinates of the inner component, clamped to its bounds, and
+    /// passed to it, so that the frame never receives it.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
     //* =====================================================================
     /// \brief Called by to_json().  Derived classes must override this
     /// function in order to add additional data about their implementation
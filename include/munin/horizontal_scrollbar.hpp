@@ -66,14 +66,14 @@ public:
     /// left instruction was received (e.g. by clicking to the left of the
     /// slider)
     //* =====================================================================
-    boost::signals2::signal<void()> on_scroll_left;
+    munin::signal<void()> on_scroll_left;
 
     //* =====================================================================
     /// \brief Connect to this signal to receive notifications when a scroll
     /// right instruction was received (e.g. by clicking to the right of the
     /// slider)
     //* =====================================================================
-    boost::signals2::signal<void()> on_scroll_right;
+    munin::signal<void()> on_scroll_right;
 
 protected:
     //* =====================================================================
@@ -113,6 +113,20 @@ protected:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Derived classes must
+    /// override this function in order to handle mouse events in a custom
+    /// manner.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     struct impl;
     std::unique_ptr<impl> pimpl_;
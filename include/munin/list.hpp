@@ -44,7 +44,7 @@ public:
     /// \brief Connect to this signal to receive notifications when the
     /// selected item has changed.
     //* =====================================================================
-    boost::signals2::signal<void()> on_item_changed;
+    munin::signal<void()> on_item_changed;
 
 private:
     //* =====================================================================
@@ -79,6 +79,27 @@ private:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Derived classes must
+    /// override this function in order to handle keypresses in a custom
+    /// manner.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Derived classes must
+    /// override this function in order to handle mouse events in a custom
+    /// manner.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
     struct impl;
     std::unique_ptr<impl> pimpl_;
 };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "munin/export.hpp"
+
+#include <functional>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A scoped guard that batches redraw notifications.
+/// \par
+/// While a transaction is open, containers accumulate the redraw regions
+/// of their subcomponents instead of announcing them immediately.  When
+/// the outermost transaction on the current thread closes, each container
+/// announces its accumulated damage once, as a single merged set of
+/// regions.  This means that a burst of redraws within one event, for
+/// example, travels up the component tree once instead of once per redraw.
+/// \par
+/// Containers similarly postpone laying out their subcomponents until the
+/// transaction closes, so that adding many subcomponents or resizing a
+/// container several times within a transaction costs one layout.
+/// \par
+/// Transactions may be nested; only the outermost one has any effect.
+/// window::event() opens a transaction around the handling of each event.
+/// \par
+/// If the outermost transaction is closed because an exception is being
+/// thrown through it, the deferred work is not run, since it may itself
+/// throw.  Instead, it is kept until the next outermost transaction on the
+/// same thread closes.
+/// \par
+/// If a deferred function throws while the outermost transaction is being
+/// closed, the transaction is still closed, and the exception is passed on
+/// to the code that closed it, as it would have been had the function been
+/// called directly.  Any functions that were deferred after it are kept
+/// until the next outermost transaction on the same thread closes.
+//* =========================================================================
+class MUNIN_EXPORT redraw_transaction
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor.  Opens a transaction.
+    //* =====================================================================
+    redraw_transaction();
+
+    //* =====================================================================
+    /// \brief Destructor.  Closes the transaction, and if it is the
+    /// outermost transaction and is not being unwound by an exception,
+    /// runs all deferred redraw notifications.  Any exception thrown by
+    /// those is passed on to the caller.
+    //* =====================================================================
+    ~redraw_transaction() noexcept(false);
+
+    redraw_transaction(redraw_transaction const &) = delete;
+    redraw_transaction &operator=(redraw_transaction const &) = delete;
+
+    //* =====================================================================
+    /// \brief Returns true if a transaction is open on the current thread.
+    //* =====================================================================
+    [[nodiscard]] static bool is_open();
+
+    //* =====================================================================
+    /// \brief Schedules a function to be called when the outermost
+    /// transaction closes.  Functions are called in the order in which they
+    /// were deferred, and any functions that they defer in turn are called
+    /// before the transaction is considered closed.
+    //* =====================================================================
+    static void defer(std::function<void()> fn);
+
+    //* =====================================================================
+    /// \brief Schedules a layout to be performed when the outermost
+    /// transaction closes.
+    /// \par
+    /// Deferred layouts are performed before any other deferred functions,
+    /// since laying components out usually causes them to be redrawn.  They
+    /// are performed most recent first: containers are usually populated
+    /// from the inside out, so this lays out enclosing containers before
+    /// the containers within them, which in turn need only be laid out once
+    /// their final size is known.
+    //* =====================================================================
+    static void defer_layout(std::function<void()> fn);
+
+private:
+    int uncaught_exceptions_;
+};
+
+}  // namespace munin
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "munin/export.hpp"
+
+#include <terminalpp/point.hpp>
+#include <terminalpp/rectangle.hpp>
+
+#include <vector>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A set of cells, represented as a collection of non-overlapping
+/// rectangles.
+/// \par
+/// A region is stored in a "banded" form: it is split vertically into
+/// bands of rows, and each band holds a sorted list of disjoint horizontal
+/// spans.  Adjacent bands with identical spans are merged, so that any
+/// given set of cells has exactly one representation.  This means that
+/// accumulating overlapping or duplicated rectangles into a region never
+/// causes a cell to be represented more than once.
+//* =========================================================================
+class MUNIN_EXPORT region
+{
+public:
+    //* =====================================================================
+    /// \brief Constructs an empty region.
+    //* =====================================================================
+    region() = default;
+
+    //* =====================================================================
+    /// \brief Constructs a region that covers the given rectangle.
+    //* =====================================================================
+    region(terminalpp::rectangle const &rect);  // NOLINT
+
+    //* =====================================================================
+    /// \brief Constructs a region that covers the union of the given
+    /// rectangles.
+    //* =====================================================================
+    explicit region(std::vector<terminalpp::rectangle> const &rects);
+
+    //* =====================================================================
+    /// \brief Returns true if the region covers no cells.
+    //* =====================================================================
+    [[nodiscard]] bool empty() const;
+
+    //* =====================================================================
+    /// \brief Returns the smallest rectangle that encloses the region.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::rectangle bounds() const;
+
+    //* =====================================================================
+    /// \brief Returns true if the given point is within the region.
+    //* =====================================================================
+    [[nodiscard]] bool contains(terminalpp::point const &pt) const;
+
+    //* =====================================================================
+    /// \brief Returns the number of cells covered by the region.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::coordinate_type area() const;
+
+    //* =====================================================================
+    /// \brief Returns a set of non-overlapping rectangles that exactly
+    /// cover the region, ordered from top to bottom and left to right.
+    //* =====================================================================
+    [[nodiscard]] std::vector<terminalpp::rectangle> rectangles() const;
+
+    //* =====================================================================
+    /// \brief Removes all cells from the region.
+    //* =====================================================================
+    void clear();
+
+    //* =====================================================================
+    /// \brief Moves every cell in the region by the given offset.
+    //* =====================================================================
+    void translate(terminalpp::point const &offset);
+
+    //* =====================================================================
+    /// \brief Adds the cells of another region to this region.
+    //* =====================================================================
+    region &operator|=(region const &rhs);
+
+    //* =====================================================================
+    /// \brief Removes any cells from this region that are not also in the
+    /// other region.
+    //* =====================================================================
+    region &operator&=(region const &rhs);
+
+    //* =====================================================================
+    /// \brief Removes the cells of another region from this region.
+    //* =====================================================================
+    region &operator-=(region const &rhs);
+
+    //* =====================================================================
+    /// \brief Equality operator.
+    //* =====================================================================
+    bool operator==(region const &rhs) const = default;
+
+private:
+    struct span
+    {
+        terminalpp::coordinate_type left_;
+        terminalpp::coordinate_type right_;
+
+        bool operator==(span const &rhs) const = default;
+    };
+
+    struct band
+    {
+        terminalpp::coordinate_type top_;
+        terminalpp::coordinate_type bottom_;
+        std::vector<span> spans_;
+
+        bool operator==(band const &rhs) const = default;
+    };
+
+    template <class Operation>
+    void combine(region const &rhs, Operation &&op);
+
+    std::vector<band> bands_;
+};
+
+//* =========================================================================
+/// \brief Returns the union of two regions.
+//* =========================================================================
+MUNIN_EXPORT
+region operator|(region lhs, region const &rhs);
+
+//* =========================================================================
+/// \brief Returns the intersection of two regions.
+//* =========================================================================
+MUNIN_EXPORT
+region operator&(region lhs, region const &rhs);
+
+//* =========================================================================
+/// \brief Returns the cells of the first region that are not in the second.
+//* =========================================================================
+MUNIN_EXPORT
+region operator-(region lhs, region const &rhs);
+
+}  // namespace munin
@@ -1,9 +1,17 @@
 #pragma once
 
+#include "munin/dirty_spans.hpp"
 #include "munin/export.hpp"
 #include "munin/render_surface_capabilities.hpp"
 
 #include <terminalpp/canvas.hpp>
+#include <terminalpp/point.hpp>
+#include <terminalpp/rectangle.hpp>
+#include <terminalpp/string.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace munin {
 
@@ -40,6 +48,54 @@ public:
         terminalpp::coordinate_type column_;
     };
 
+    //* =====================================================================
+    /// \brief A read-only proxy into a column of elements on the canvas
+    //* =====================================================================
+    class MUNIN_EXPORT const_column_proxy
+    {
+    public:
+        using size_type = terminalpp::coordinate_type;
+
+        // ==================================================================
+        // CONSTRUCTOR
+        // ==================================================================
+        const_column_proxy(
+            render_surface const &surface, terminalpp::coordinate_type column);
+
+        // ==================================================================
+        // OPERATOR[]
+        // ==================================================================
+        terminalpp::element operator[](terminalpp::coordinate_type row) const;
+
+    private:
+        render_surface const &surface_;
+        terminalpp::coordinate_type column_;
+    };
+
+    //* =====================================================================
+    /// \brief A guard that pushes a clip rectangle onto a surface for the
+    /// duration of its lifetime.
+    //* =====================================================================
+    class MUNIN_EXPORT scoped_clip
+    {
+    public:
+        // ==================================================================
+        // CONSTRUCTOR
+        // ==================================================================
+        scoped_clip(render_surface &surface, terminalpp::rectangle const &clip);
+
+        // ==================================================================
+        // DESTRUCTOR
+        // ==================================================================
+        ~scoped_clip();
+
+        scoped_clip(scoped_clip const &) = delete;
+        scoped_clip &operator=(scoped_clip const &) = delete;
+
+    private:
+        render_surface &surface_;
+    };
+
     //* =====================================================================
     /// \brief Constructor
     //* =====================================================================
@@ -52,6 +108,20 @@ public:
         terminalpp::canvas &cvs,
         render_surface_capabilities const &capabilities);
 
+    //* =====================================================================
+    /// \brief Constructor that records changes to the canvas.
+    /// \par
+    /// Elements written through write_row, fill and tile are compared with
+    /// the existing content of the canvas, and only those that differ are
+    /// written and recorded in dirty.  Elements that are accessed through
+    /// the subscript operators or row_span cannot be compared, and so are
+    /// always recorded as changed.
+    //* =====================================================================
+    render_surface(
+        terminalpp::canvas &cvs,
+        render_surface_capabilities const &capabilities,
+        dirty_spans &dirty);
+
     //* =====================================================================
     /// \brief Returns true if the surface is known to support unicode.
     /// characters.  Attempting to render unicode on surfaces that do not
@@ -70,21 +140,151 @@ public:
     //* =====================================================================
     [[nodiscard]] terminalpp::extent size() const;
 
+    //* =====================================================================
+    /// \brief Restricts drawing to the given rectangle, which is relative
+    /// to the current offset, in addition to any existing clip.  Note that
+    /// the clip is not itself restricted to the bounds of the canvas.
+    /// \par
+    /// Writes through row_span, write_row, fill and tile are confined to
+    /// the clip rectangle.  Elements outside of the clip rectangle may
+    /// still be accessed through the subscript operators, and hold the
+    /// content of the canvas when they are accessed, but any changes made
+    /// to them are discarded.
+    //* =====================================================================
+    void push_clip(terminalpp::rectangle const &clip);
+
+    //* =====================================================================
+    /// \brief Removes the most recently pushed clip rectangle.
+    //* =====================================================================
+    void pop_clip();
+
+    //* =====================================================================
+    /// \brief Returns the area of the surface that can currently be drawn
+    /// to, relative to the current offset.  If no clip has been pushed,
+    /// this is the entire underlying canvas.  A component can use this to
+    /// avoid doing work for parts of itself that cannot be seen.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::rectangle clip_rect() const;
+
     //* =====================================================================
     /// \brief A subscript operator into a column
     //* =====================================================================
     column_proxy operator[](terminalpp::coordinate_type column);
 
+    //* =====================================================================
+    /// \brief A read-only subscript operator into a column.  Elements read
+    /// in this way are copies, and are neither counted as written nor
+    /// recorded as changed.  Elements that lie outside of the canvas read
+    /// as default elements.
+    //* =====================================================================
+    const_column_proxy operator[](terminalpp::coordinate_type column) const;
+
+    //* =====================================================================
+    /// \brief Returns a contiguous run of the elements in a single row of
+    /// the surface, beginning at origin and extending for at most length
+    /// elements.
+    /// \par
+    /// The run is truncated at the right-hand edge of the surface, and is
+    /// empty if origin lies outside of the surface.  Writing through the
+    /// returned span is equivalent to, but considerably cheaper than,
+    /// writing each element in turn through the subscript operators.  The
+    /// span is invalidated by any operation that resizes the canvas.
+    //* =====================================================================
+    [[nodiscard]] std::span<terminalpp::element> row_span(
+        terminalpp::point origin, size_type length);
+
+    //* =====================================================================
+    /// \brief Copies a run of elements into a single row of the surface,
+    /// beginning at origin.  Any elements that would lie outside of the
+    /// surface are discarded.
+    //* =====================================================================
+    void write_row(
+        terminalpp::point origin,
+        std::span<terminalpp::element const> elements);
+
+    //* =====================================================================
+    /// \brief Sets every element within the given region of the surface
+    /// to the given element.  Any part of the region that lies outside of
+    /// the surface is ignored.
+    //* =====================================================================
+    void fill(
+        terminalpp::rectangle const &region, terminalpp::element const &elem);
+
+    //* =====================================================================
+    /// \brief Covers the given region of the surface with a repeating
+    /// pattern.
+    /// \par
+    /// The pattern is anchored at the origin of the surface, so that the
+    /// element at (column, row) is taken from row (row % pattern.size()) of
+    /// the pattern, at column (column % line.size()) of that row.  Any part
+    /// of the region that lies outside of the surface is ignored.
+    //* =====================================================================
+    void tile(
+        terminalpp::rectangle const &region,
+        std::vector<terminalpp::string> const &pattern);
+
+    //* =====================================================================
+    /// \brief Returns the number of cells that have been written through
+    /// this surface, whether or not their content changed.  Cells that were
+    /// clipped away do not count.  The non-const subscript operators and
+    /// row_span hand out elements that may be written to, and so each
+    /// element accessed through them within the clip counts as written;
+    /// elements that are only to be read should be read through the const
+    /// subscript operators, which are not counted.
+    //* =====================================================================
+    [[nodiscard]] std::uint64_t cells_written() const;
+
 private:
+    //* =====================================================================
+    /// \brief Returns a run of elements as per row_span, but without
+    /// recording them as changed.
+    //* =====================================================================
+    [[nodiscard]] std::span<terminalpp::element> unrecorded_row_span(
+        terminalpp::point origin, size_type length);
+
+    //* =====================================================================
+    /// \brief Records that the elements from first up to but not including
+    /// last of the given run of elements have changed.
+    //* =====================================================================
+    void record_changes(
+        std::span<terminalpp::element const> elements,
+        std::size_t first,
+        std::size_t last);
+
+    //* =====================================================================
+    /// \brief Returns the part of the underlying canvas that may currently
+    /// be written to, in the co-ordinates of that canvas.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::rectangle canvas_clip() const;
+
+    //* =====================================================================
+    /// \brief Returns the given region, with any columns that lie to the
+    /// left of the clip rectangle removed.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::rectangle clip_left(
+        terminalpp::rectangle region) const;
+
     //* =====================================================================
     /// \brief Gets an element from the underlying canvas.
     //* =====================================================================
     terminalpp::element &get_element(
         terminalpp::coordinate_type column, terminalpp::coordinate_type row);
 
+    //* =====================================================================
+    /// \brief Returns a copy of an element of the underlying canvas, or a
+    /// default element if the position lies outside of the canvas.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::element read_element(
+        terminalpp::coordinate_type column,
+        terminalpp::coordinate_type row) const;
+
     terminalpp::canvas &canvas_;
     render_surface_capabilities const &capabilities_;
     terminalpp::extent offset_;
+    std::vector<terminalpp::rectangle> clips_;
+    terminalpp::element clipped_element_;
+    dirty_spans *dirty_{nullptr};
+    std::uint64_t cells_written_{0};
 };
 
 }  // namespace munin
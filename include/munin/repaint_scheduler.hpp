@@ -0,0 +1,91 @@
+#pragma once
+
+#include "munin/export.hpp"
+#include "munin/signal.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief An injectable interface that paces the repainting of a window.
+/// \par
+/// Repaint requests that arrive within a frame interval of each other are
+/// coalesced into a single repaint, which is announced by on_repaint.  If
+/// repainting falls behind, frames are skipped rather than queued, so that
+/// at most one repaint is ever outstanding.
+/// \par
+/// The expected usage is to connect window::on_repaint_request to
+/// request_repaint(), and on_repaint to window::repaint().
+//* =========================================================================
+class MUNIN_EXPORT repaint_scheduler
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    repaint_scheduler();
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    virtual ~repaint_scheduler();
+
+    //* =====================================================================
+    /// \brief Sets the minimum time between two repaints.  For example,
+    /// a frame interval of 33ms limits repaints to roughly 30 per second.
+    /// The default is 16ms.
+    //* =====================================================================
+    void set_frame_interval(std::chrono::steady_clock::duration interval);
+
+    //* =====================================================================
+    /// \brief Returns the minimum time between two repaints.
+    //* =====================================================================
+    [[nodiscard]] std::chrono::steady_clock::duration frame_interval() const;
+
+    //* =====================================================================
+    /// \brief Requests that a repaint happen at the start of the next
+    /// available frame.  Requests made while a repaint is already pending
+    /// are merged into that repaint.
+    //* =====================================================================
+    void request_repaint();
+
+    //* =====================================================================
+    /// \brief Returns the current time
+    //* =====================================================================
+    [[nodiscard]] std::chrono::steady_clock::time_point now() const;
+
+    //* =====================================================================
+    /// \fn on_repaint
+    /// \brief Connect to this signal in order to receive notifications that
+    /// a frame has started and any pending changes should be repainted.
+    //* =====================================================================
+    munin::signal<void()> on_repaint;  // NOLINT
+
+protected:
+    //* =====================================================================
+    /// \brief Starts a frame, announcing any pending repaint.  This must be
+    /// called from a derived class after its own timer has expired.  The
+    /// timer is set in reset_timer(execution_time).
+    //* =====================================================================
+    void start_frame();
+
+private:
+    //* =====================================================================
+    /// \brief Schedules start_frame() to be called at a certain time.
+    //* =====================================================================
+    virtual void reset_timer(
+        std::chrono::steady_clock::time_point execution_time) = 0;
+
+    //* =====================================================================
+    /// \brief Returns the current time
+    //* =====================================================================
+    [[nodiscard]] virtual std::chrono::steady_clock::time_point do_now()
+        const = 0;
+
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+}  // namespace munin
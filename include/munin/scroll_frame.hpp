@@ -91,6 +91,13 @@ protected:
     //* =====================================================================
     void do_inner_focus_changed() override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     struct impl;
     std::unique_ptr<impl> pimpl_;
@@ -43,6 +43,14 @@ public:
     //* =====================================================================
     void set_lowlight_attribute(terminalpp::attribute const &attr);
 
+protected:
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     scroll_pane(
         std::shared_ptr<component> const &frame,
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef MUNIN_WITH_SINGLE_THREADED_SIGNALS
+#include "munin/detail/single_threaded_signal.hpp"
+#else
+#include <boost/signals2/connection.hpp>
+#include <boost/signals2/signal.hpp>
+#endif
+
+namespace munin {
+
+//* =========================================================================
+/// \brief The type of the signals with which components and other Munin
+/// objects announce changes.
+/// \par
+/// By default, this is boost::signals2::signal.  If Munin is built with
+/// MUNIN_WITH_SINGLE_THREADED_SIGNALS=True, then it is instead a lighter
+/// signal with the same interface for connecting, disconnecting and
+/// emitting, but which must only be used from one thread at a time.
+/// Since a component is only ever used from one strand, this is usually
+/// the case.
+//* =========================================================================
+#ifdef MUNIN_WITH_SINGLE_THREADED_SIGNALS
+template <class Signature>
+using signal = detail::single_threaded_signal<Signature>;
+
+using connection = detail::single_threaded_connection;
+#else
+template <class Signature>
+using signal = boost::signals2::signal<Signature>;
+
+using connection = boost::signals2::connection;
+#endif
+
+}  // namespace munin
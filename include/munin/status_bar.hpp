@@ -51,6 +51,13 @@ private:
     void do_draw(render_surface &surface, terminalpp::rectangle const &region)
         const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
     struct impl;
     std::unique_ptr<impl> pimpl_;
 };
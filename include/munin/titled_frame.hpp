@@ -59,6 +59,13 @@ protected:
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
     //* =====================================================================
     /// \brief Called when the focus of the associated component has changed
     /// Derived classes must override this to provide appropriate redraw
@@ -28,7 +28,7 @@ public:
     /// \fn on_state_changed
     /// An event that fires when the toggle state of the button changes.
     //* =====================================================================
-    boost::signals2::signal<void(bool)> on_state_changed;
+    munin::signal<void(bool)> on_state_changed;
 
 protected:
     //* =====================================================================
@@ -37,6 +37,18 @@ protected:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Enter and space flip
+    /// the toggle state; other keys are ignored.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Pressing the left
+    /// button flips the toggle state; other events are ignored.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
     //* =====================================================================
     /// \brief Called by to_json().  Derived classes must override this
     /// function in order to add additional data about their implementation
@@ -44,6 +56,13 @@ protected:
     //* =====================================================================
     [[nodiscard]] nlohmann::json do_to_json() const override;
 
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     struct impl;
     std::unique_ptr<impl> pimpl_;
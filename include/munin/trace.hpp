@@ -0,0 +1,177 @@
+#pragma once
+
+//* =========================================================================
+/// \file
+/// \brief Optional instrumentation of component drawing and event handling.
+/// \par
+/// This is only available if Munin is built with MUNIN_WITH_TRACING=True.
+/// Otherwise, the MUNIN_TRACE macro expands to nothing and none of the
+/// types below are declared.
+/// \par
+/// When enabled, each call to component::draw() and component::event() is
+/// timed and recorded into a fixed-size ring buffer, which can then be
+/// exported in the Chrome Trace Event format and loaded into a trace
+/// viewer such as chrome://tracing or Perfetto.  Components may be drawn
+/// from several threads, and so the buffer is guarded by a mutex and each
+/// event records the thread on which it happened:
+/// \code
+/// std::ofstream{"frame.json"} << munin::global_trace_buffer().to_json();
+/// \endcode
+//* =========================================================================
+
+#ifdef MUNIN_WITH_TRACING
+
+#include "munin/export.hpp"
+
+#include <nlohmann/json.hpp>
+#include <terminalpp/rectangle.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace munin {
+
+class component;
+
+//* =========================================================================
+/// \brief A single recorded draw or event call.
+//* =========================================================================
+struct trace_event
+{
+    //* =====================================================================
+    /// \brief The kind of operation; either "draw" or "event".
+    //* =====================================================================
+    char const *category = "";
+
+    //* =====================================================================
+    /// \brief The demangled name of the dynamic type of the component.
+    //* =====================================================================
+    std::string type;
+
+    //* =====================================================================
+    /// \brief The size of the region drawn, if any.
+    //* =====================================================================
+    terminalpp::extent region_size;
+
+    //* =====================================================================
+    /// \brief The number of cells in the region drawn, if any.
+    //* =====================================================================
+    std::uint64_t cells = 0;
+
+    //* =====================================================================
+    /// \brief The time at which the operation started.
+    //* =====================================================================
+    std::chrono::steady_clock::time_point start;
+
+    //* =====================================================================
+    /// \brief The time taken by the operation, including any nested
+    /// operations on subcomponents.
+    //* =====================================================================
+    std::chrono::steady_clock::duration duration{};
+
+    //* =====================================================================
+    /// \brief The thread on which the operation happened.
+    //* =====================================================================
+    std::thread::id thread;
+};
+
+//* =========================================================================
+/// \brief A ring buffer of trace events.  Once full, each new event
+/// overwrites the oldest one.
+//* =========================================================================
+class MUNIN_EXPORT trace_buffer
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    explicit trace_buffer(std::size_t capacity = 65536);
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~trace_buffer();
+
+    //* =====================================================================
+    /// \brief Records an event into the buffer.  This may be called from
+    /// any thread.
+    //* =====================================================================
+    void record(trace_event ev);
+
+    //* =====================================================================
+    /// \brief Returns the demangled name of the dynamic type of the
+    /// component.  This is cached per type, so that only the first lookup
+    /// pays for the demangling.
+    //* =====================================================================
+    [[nodiscard]] std::string const &type_of(component const &comp);
+
+    //* =====================================================================
+    /// \brief Returns the recorded events, oldest first.
+    //* =====================================================================
+    [[nodiscard]] std::vector<trace_event> events() const;
+
+    //* =====================================================================
+    /// \brief Removes all recorded events.
+    //* =====================================================================
+    void clear();
+
+    //* =====================================================================
+    /// \brief Returns the recorded events in the Chrome Trace Event JSON
+    /// format.  Threads are numbered in the order in which they first
+    /// appear in the buffer.
+    //* =====================================================================
+    [[nodiscard]] nlohmann::json to_json() const;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+//* =========================================================================
+/// \brief Returns the buffer into which component operations are traced.
+//* =========================================================================
+MUNIN_EXPORT
+trace_buffer &global_trace_buffer();
+
+//* =========================================================================
+/// \brief Records the duration of its own lifetime as a trace event in the
+/// global trace buffer.
+//* =========================================================================
+class MUNIN_EXPORT trace_scope
+{
+public:
+    //* =====================================================================
+    /// \brief Constructor
+    //* =====================================================================
+    trace_scope(
+        char const *category,
+        component const &comp,
+        terminalpp::rectangle const &region = {});
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~trace_scope();
+
+    trace_scope(trace_scope const &) = delete;
+    trace_scope &operator=(trace_scope const &) = delete;
+
+private:
+    trace_event event_;
+};
+
+}  // namespace munin
+
+#define MUNIN_TRACE(...) \
+    ::munin::trace_scope const munin_trace_scope_ { __VA_ARGS__ }
+
+#else
+
+#define MUNIN_TRACE(...)
+
+#endif
@@ -65,13 +65,13 @@ public:
     /// \brief Connect to this signal to receive notifications when a scroll
     /// left instruction was received (e.g. by clicking above the slider).
     //* =====================================================================
-    boost::signals2::signal<void()> on_scroll_up;  // NOLINT
+    munin::signal<void()> on_scroll_up;  // NOLINT
 
     //* =====================================================================
     /// \brief Connect to this signal to receive notifications when a scroll
     /// right instruction was received (e.g. by clicking below the slider).
     //* =====================================================================
-    boost::signals2::signal<void()> on_scroll_down;  // NOLINT
+    munin::signal<void()> on_scroll_down;  // NOLINT
 
 protected:
     //* =====================================================================
@@ -111,6 +111,20 @@ protected:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Derived classes must
+    /// override this function in order to handle mouse events in a custom
+    /// manner.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
 private:
     struct impl;
     std::unique_ptr<impl> pimpl_;
@@ -2,6 +2,7 @@
 
 #include "munin/container.hpp"
 #include "munin/layout.hpp"
+#include "munin/redraw_transaction.hpp"
 
 #include <any>
 #include <memory>
@@ -73,6 +74,10 @@ inline void view_helper(
 template <class... Args>
 std::shared_ptr<container> view(std::unique_ptr<layout> lyt, Args &&...args)
 {
+    // The container is only laid out once all of its components have been
+    // added.
+    redraw_transaction const transaction;
+
     auto comp = munin::make_container();
     comp->set_layout(std::move(lyt));
     detail::view_helper(
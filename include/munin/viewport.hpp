@@ -66,7 +66,7 @@ public:
     /// \brief Connect to this signal in order to receive notifications when
     /// the anchor bounds have changed.
     //* =====================================================================
-    boost::signals2::signal<void()> on_anchor_bounds_changed;  // NOLINT
+    munin::signal<void()> on_anchor_bounds_changed;  // NOLINT
 
 private:
     //* =====================================================================
@@ -147,6 +147,27 @@ private:
     //* =====================================================================
     void do_event(std::any const &event) override;
 
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Page up and page down move
+    /// the cursor of the tracked component by the height of the viewport;
+    /// other keys are passed on to the tracked component.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  The event is offset by
+    /// the origin of the anchor bounds and passed on to the tracked
+    /// component.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
     struct impl;
     std::unique_ptr<impl> pimpl_;
 };
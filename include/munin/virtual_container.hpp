@@ -0,0 +1,188 @@
+#pragma once
+
+#include "munin/basic_component.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A component that displays a long column of rows, but only
+/// creates the rows that are being drawn.
+/// \par
+/// Each row is a component of a fixed height that spans the width of the
+/// virtual_container.  Rows are created on demand by a factory as they are
+/// drawn, or as events are sent to them, and are recycled once they have
+/// not been drawn for a while.  In particular, when placed in a viewport
+/// or scroll_pane, only the rows that can be seen are kept, so that the
+/// memory and layout cost is proportional to the visible area rather than
+/// to the number of rows.
+/// \par
+/// The cursor of a virtual_container is within its current row, which is
+/// moved with the up and down cursor keys or the mouse, so that a viewport
+/// will follow it.  Any other keypresses are sent to the current row, which
+/// has focus whenever the virtual_container does, and whose cursor state
+/// and position are those of the virtual_container.
+//* =========================================================================
+class MUNIN_EXPORT virtual_container : public basic_component
+{
+public:
+    //* =====================================================================
+    /// \brief A function that returns the row at the given index.  If a
+    /// previously created row has been recycled, then it is passed to the
+    /// factory, which may update and return it rather than creating a new
+    /// row.  Otherwise, it is null.
+    //* =====================================================================
+    using row_factory = std::function<std::shared_ptr<component>(
+        std::size_t index, std::shared_ptr<component> recycled)>;
+
+    //* =====================================================================
+    /// \brief Constructor
+    /// \param factory the function that creates each row.
+    /// \param row_count the number of rows.
+    /// \param row_height the height of each row.
+    //* =====================================================================
+    virtual_container(
+        row_factory factory,
+        std::size_t row_count,
+        terminalpp::coordinate_type row_height = 1);
+
+    //* =====================================================================
+    /// \brief Destructor
+    //* =====================================================================
+    ~virtual_container() override;
+
+    //* =====================================================================
+    /// \brief Returns the number of rows.
+    //* =====================================================================
+    [[nodiscard]] std::size_t get_row_count() const;
+
+    //* =====================================================================
+    /// \brief Sets the number of rows.  Any created rows beyond the new
+    /// number of rows are recycled.
+    //* =====================================================================
+    void set_row_count(std::size_t row_count);
+
+    //* =====================================================================
+    /// \brief Returns the height of each row.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::coordinate_type get_row_height() const;
+
+    //* =====================================================================
+    /// \brief Returns the index of the current row, if there are any rows.
+    //* =====================================================================
+    [[nodiscard]] std::optional<std::size_t> get_current_row() const;
+
+    //* =====================================================================
+    /// \brief Recycles every created row, so that each row is fetched
+    /// from the factory again when it is next needed.  This should be
+    /// called when the data that the rows display has changed.
+    //* =====================================================================
+    void refresh_rows();
+
+    //* =====================================================================
+    /// \brief Returns the number of rows that currently exist, which does
+    /// not include any recycled rows that are waiting to be reused.
+    //* =====================================================================
+    [[nodiscard]] std::size_t get_materialized_row_count() const;
+
+protected:
+    //* =====================================================================
+    /// \brief Called by set_size().  Derived classes must override this
+    /// function in order to set the size of the component in a custom
+    /// manner.
+    //* =====================================================================
+    void do_set_size(terminalpp::extent const &size) override;
+
+    //* =====================================================================
+    /// \brief Called by get_preferred_size().  Derived classes must override
+    /// this function in order to get the size of the component in a custom
+    /// manner.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::extent do_get_preferred_size() const override;
+
+    //* =====================================================================
+    /// \brief Called by get_cursor_state().  Derived classes must override
+    /// this function in order to return the cursor state in a custom
+    /// manner.
+    //* =====================================================================
+    [[nodiscard]] bool do_get_cursor_state() const override;
+
+    //* =====================================================================
+    /// \brief Called by get_cursor_position().  Derived classes must
+    /// override this function in order to return the cursor position in
+    /// a custom manner.
+    //* =====================================================================
+    [[nodiscard]] terminalpp::point do_get_cursor_position() const override;
+
+    //* =====================================================================
+    /// \brief Called by set_cursor_position().  Derived classes must
+    /// override this function in order to set the cursor position in
+    /// a custom manner.
+    //* =====================================================================
+    void do_set_cursor_position(terminalpp::point const &position) override;
+
+    //* =====================================================================
+    /// \brief Called by draw().  Derived classes must override this function
+    /// in order to draw onto the passed context.  A component must only draw
+    /// the part of itself specified by the region.
+    ///
+    /// \param surface the surface on which the component should draw itself.
+    /// \param region the region relative to this component's origin that
+    /// should be drawn.
+    //* =====================================================================
+    void do_draw(render_surface &surface, terminalpp::rectangle const &region)
+        const override;
+
+    //* =====================================================================
+    /// \brief Called by event().  Derived classes must override this
+    /// function in order to handle events in a custom manner.
+    //* =====================================================================
+    void do_event(std::any const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for keypresses.  Derived classes must
+    /// override this function in order to handle keypresses in a custom
+    /// manner.
+    //* =====================================================================
+    void do_key_event(terminalpp::virtual_key const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by event() for mouse events.  Derived classes must
+    /// override this function in order to handle mouse events in a custom
+    /// manner.
+    //* =====================================================================
+    void do_mouse_event(terminalpp::mouse::event const &event) override;
+
+    //* =====================================================================
+    /// \brief Called by to_json().  Derived classes must override this
+    /// function in order to add additional data about their implementation
+    /// in a custom manner.
+    //* =====================================================================
+    [[nodiscard]] nlohmann::json do_to_json() const override;
+
+    //* =====================================================================
+    /// \brief Called by census().  Derived classes may override this
+    /// function in order to add the memory and signals used by their
+    /// implementation and to add the components of which they are composed.
+    //* =====================================================================
+    void do_census(component_census &cen) const override;
+
+private:
+    struct impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+//* =========================================================================
+/// \brief Returns a newly created virtual_container
+//* =========================================================================
+MUNIN_EXPORT
+std::shared_ptr<virtual_container> make_virtual_container(
+    virtual_container::row_factory factory,
+    std::size_t row_count,
+    terminalpp::coordinate_type row_height = 1);
+
+}  // namespace munin
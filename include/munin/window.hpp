@@ -1,21 +1,27 @@
 #pragma once
 
+#include "munin/compact_canvas.hpp"
 #include "munin/component.hpp"
+#include "munin/component_census.hpp"
+#include "munin/dirty_spans.hpp"
 #include "munin/export.hpp"
+#include "munin/region.hpp"
 #include "munin/render_surface_capabilities.hpp"
+#include "munin/signal.hpp"
+#include "munin/window_statistics.hpp"
 
-#include <boost/signals2/signal.hpp>
 #include <nlohmann/json.hpp>
 #include <terminalpp/canvas.hpp>
 #include <terminalpp/extent.hpp>
-#include <terminalpp/screen.hpp>
 #include <terminalpp/terminal.hpp>
 
 #include <any>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
-
 namespace munin {
 
 //* =========================================================================
@@ -51,16 +57,87 @@ public:
 
     //* =====================================================================
     /// \brief Send an event to the window.  This will be passed straight to
-    /// the content.
+    /// the content.  Any redraws caused by the event are batched in a
+    /// redraw_transaction.
     //* =====================================================================
     void event(std::any const &ev);
 
+    //* =====================================================================
+    /// \brief Send a keypress to the window.  This behaves as event() does
+    /// for events of any type, but the keypress is passed down the
+    /// component tree without being boxed into a std::any.
+    //* =====================================================================
+    void event(terminalpp::virtual_key const &ev);
+
+    //* =====================================================================
+    /// \brief Send a mouse event to the window.  This behaves as event()
+    /// does for events of any type, but the event is passed down the
+    /// component tree without being boxed into a std::any.
+    //* =====================================================================
+    void event(terminalpp::mouse::event const &ev);
+
     //* =====================================================================
     /// \brief Writes a string to the terminal that represents the changes
     /// on the canvas since it was last painted.
+    /// \par
+    /// Only the cells within the regions that the content has requested to
+    /// be redrawn are compared against the previous frame, so the cost of
+    /// a repaint is proportional to the size of the damage rather than the
+    /// size of the canvas.  Furthermore, if the same canvas is repainted
+    /// each time, then only those cells whose content was actually changed
+    /// by the drawing are compared.
+    /// \par
+    /// The window does not check the canvas for changes that it did not
+    /// make, since doing so would cost as much as comparing the whole
+    /// canvas.  It is therefore a precondition of this function that a
+    /// canvas that was painted before has not been modified since, other
+    /// than by this window.  Any cells that are modified otherwise are not
+    /// sent to the terminal until the content next redraws them, and a
+    /// repaint of the whole canvas can be forced by resizing it.
+    /// \par
+    /// A canvas is recognised as the same one as last time by its address,
+    /// the address of its elements and its size.  Replacing the canvas by
+    /// moving another into it, or resizing it, is therefore detected.
+    /// Copying another canvas of the same size into it is not, since that
+    /// reuses the same elements, and counts as modifying it.
+    /// \par
+    /// Everything written for the repaint is written within a single batch
+    /// of output.  See batch_output().
     //* =====================================================================
     void repaint(terminalpp::canvas &cvs);
 
+    //* =====================================================================
+    /// \brief Returns counters describing the repainting activity of the
+    /// window.
+    //* =====================================================================
+    [[nodiscard]] window_statistics const &statistics() const;
+
+    //* =====================================================================
+    /// \brief Sets a function that returns the number of bytes written so
+    /// far to the channel of the window's terminal, for example the
+    /// bytes_written() of a byte_counting_channel.  The bytes written while
+    /// the window is repainting are counted in the bytes_emitted statistic.
+    /// Until this is set, bytes_emitted remains zero.
+    //* =====================================================================
+    void measure_output(std::function<std::uint64_t()> bytes_written);
+
+    //* =====================================================================
+    /// \brief Sets functions that are called before and after the window
+    /// writes a repaint to its terminal, for example the begin_batch() and
+    /// end_batch() of a batching_channel.  This allows all of the output of
+    /// a repaint to reach the channel of the terminal in a single write,
+    /// rather than in one write for each run of changed cells.
+    //* =====================================================================
+    void batch_output(
+        std::function<void()> begin_batch, std::function<void()> end_batch);
+
+    //* =====================================================================
+    /// \brief Returns a census of the window and of the tree of components
+    /// that it displays.  The totals of the census are the figures for the
+    /// window as a whole.
+    //* =====================================================================
+    [[nodiscard]] component_census census() const;
+
     //* =====================================================================
     /// \brief Returns a JSON representation of the current state of the
     /// window and its content.
@@ -72,12 +149,33 @@ public:
     /// \brief Connect to this signal in order to receive notifications that
     /// the content of the window has been changed and required repainting.
     //* =====================================================================
-    boost::signals2::signal<void()> on_repaint_request;  // NOLINT
+    munin::signal<void()> on_repaint_request;  // NOLINT
 
 private:
+    // Identifies the canvas that was last painted, in order to tell
+    // whether it is being painted again.
+    struct canvas_identity
+    {
+        terminalpp::canvas const *canvas = nullptr;
+        terminalpp::element const *elements = nullptr;
+        terminalpp::extent size;
+
+        bool operator==(canvas_identity const &) const = default;
+    };
+
+    static canvas_identity identify(terminalpp::canvas const &cvs);
+
     std::shared_ptr<component> content_;
-    std::vector<terminalpp::rectangle> repaint_regions_;
-    terminalpp::screen screen_;
+    region repaint_region_;
+    bool repaint_requested_ = false;
+    terminalpp::terminal &terminal_;
+    std::function<std::uint64_t()> bytes_written_;
+    std::function<void()> begin_batch_;
+    std::function<void()> end_batch_;
+    std::optional<compact_canvas> last_frame_;
+    canvas_identity last_canvas_;
+    dirty_spans dirty_;
+    window_statistics statistics_;
     render_surface_capabilities const &capabilities_;
 };
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace munin {
+
+//* =========================================================================
+/// \brief A set of counters that describe the repainting activity of a
+/// window since it was created.
+//* =========================================================================
+struct window_statistics
+{
+    //* =====================================================================
+    /// \brief The number of redraw requests received from the content.
+    //* =====================================================================
+    std::uint64_t repaint_requests = 0;
+
+    //* =====================================================================
+    /// \brief The number of times the window has been repainted.
+    //* =====================================================================
+    std::uint64_t repaints = 0;
+
+    //* =====================================================================
+    /// \brief The number of regions requested by the content, before
+    /// they were coalesced.
+    //* =====================================================================
+    std::uint64_t regions_requested = 0;
+
+    //* =====================================================================
+    /// \brief The number of regions actually drawn, after coalescing.
+    //* =====================================================================
+    std::uint64_t regions_drawn = 0;
+
+    //* =====================================================================
+    /// \brief The total area, in cells, of the regions that the content
+    /// was asked to draw.  This is not the number of cells that the content
+    /// actually wrote (see cells_written), since a component need not draw
+    /// every cell within the region that it is given.
+    //* =====================================================================
+    std::uint64_t region_area = 0;
+
+    //* =====================================================================
+    /// \brief The number of cells that the content wrote to the canvas
+    /// while it was being drawn, whether or not their content changed.
+    //* =====================================================================
+    std::uint64_t cells_written = 0;
+
+    //* =====================================================================
+    /// \brief The number of cells that were sent to the terminal, either
+    /// because they changed or because the whole canvas was painted.
+    //* =====================================================================
+    std::uint64_t cells_changed = 0;
+
+    //* =====================================================================
+    /// \brief The number of bytes written to the terminal's channel while
+    /// the window was repainting.  This is only counted if the window has
+    /// been given a way to measure its output with window::measure_output().
+    //* =====================================================================
+    std::uint64_t bytes_emitted = 0;
+
+    //* =====================================================================
+    /// \brief The total time spent drawing the content.
+    //* =====================================================================
+    std::chrono::steady_clock::duration draw_time{};
+
+    //* =====================================================================
+    /// \brief The total time spent comparing frames and writing the
+    /// changes to the terminal.
+    //* =====================================================================
+    std::chrono::steady_clock::duration paint_time{};
+};
+
+}  // namespace munin
@@ -0,0 +1,43 @@
+#include "munin/background_repaint_scheduler.hpp"
+
+namespace munin {
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+background_repaint_scheduler::background_repaint_scheduler(
+    boost::asio::any_io_executor const &executor)
+  : timer_(executor)
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+background_repaint_scheduler::~background_repaint_scheduler() = default;
+
+// ==========================================================================
+// RESET_TIMER
+// ==========================================================================
+void background_repaint_scheduler::reset_timer(
+    std::chrono::steady_clock::time_point execution_time)
+{
+    timer_.expires_at(execution_time);
+    timer_.async_wait([this](boost::system::error_code const &ec) {
+        if (!ec)
+        {
+            start_frame();
+        }
+    });
+}
+
+// ==========================================================================
+// DO_NOW
+// ==========================================================================
+std::chrono::steady_clock::time_point background_repaint_scheduler::do_now()
+    const
+{
+    return std::chrono::steady_clock::now();
+}
+
+}  // namespace munin
@@ -1,11 +1,12 @@
 #include "munin/brush.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/render_surface.hpp"
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/max_element.hpp>
-#include <terminalpp/algorithm/for_each_in_region.hpp>
 
+#include <algorithm>
 #include <utility>
 
 using namespace terminalpp::literals;  // NOLINT
@@ -71,6 +72,17 @@ bool brush::do_can_receive_focus() const
     return false;
 }
 
+// ==========================================================================
+// DO_IS_OPAQUE
+// ==========================================================================
+bool brush::do_is_opaque() const
+{
+    // An empty pattern, or an empty line within it, leaves cells untouched.
+    auto const &is_empty = [](auto const &line) { return line.empty(); };
+
+    return !pattern_.empty() && std::ranges::none_of(pattern_, is_empty);
+}
+
 // ==========================================================================
 // DO_GET_PREFERRED_SIZE
 // ==========================================================================
@@ -94,18 +106,7 @@ terminalpp::extent brush::do_get_preferred_size() const
 void brush::do_draw(
     render_surface &surface, terminalpp::rectangle const &region) const
 {
-    terminalpp::for_each_in_region(
-        surface,
-        region,
-        [this](
-            terminalpp::element &elem,
-            terminalpp::coordinate_type column,  // NOLINT
-            terminalpp::coordinate_type row) {
-            auto const fill_row = row % pattern_.size();
-            auto const fill_column = column % pattern_[fill_row].size();
-
-            elem = pattern_[fill_row][fill_column];
-        });
+    surface.tile(region, pattern_);
 }
 
 // ==========================================================================
@@ -130,6 +131,16 @@ nlohmann::json brush::do_to_json() const
     return json;
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void brush::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this), component_census::estimate_string_bytes(pattern_));
+}
+
 // ==========================================================================
 // MAKE_BRUSH
 // ==========================================================================
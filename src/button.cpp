@@ -1,5 +1,6 @@
 #include "munin/button.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/framed_component.hpp"
 #include "munin/grid_layout.hpp"
 #include "munin/image.hpp"
@@ -34,20 +35,35 @@ void button::do_event(std::any const &ev)
     if (auto const *mouse_event = std::any_cast<terminalpp::mouse::event>(&ev);
         mouse_event != nullptr)
     {
-        if (mouse_event->action_
-            == terminalpp::mouse::event_type::left_button_down)
-        {
-            on_click();
-        }
+        do_mouse_event(*mouse_event);
     }
     else if (auto const *vk = std::any_cast<terminalpp::virtual_key>(&ev);
              vk != nullptr)
     {
-        if (vk->key == terminalpp::vk::enter
-            || vk->key == terminalpp::vk::space)
-        {
-            on_click();
-        }
+        do_key_event(*vk);
+    }
+}
+
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void button::do_key_event(terminalpp::virtual_key const &event)
+{
+    if (event.key == terminalpp::vk::enter
+        || event.key == terminalpp::vk::space)
+    {
+        on_click();
+    }
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void button::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    if (event.action_ == terminalpp::mouse::event_type::left_button_down)
+    {
+        on_click();
     }
 }
 
@@ -63,6 +79,15 @@ nlohmann::json button::do_to_json() const
     return composite_component::do_to_json().patch(patch);
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void button::do_census(component_census &cen) const
+{
+    composite_component::do_census(cen);
+    cen.add_signal(typeid(*this), on_click);
+}
+
 // ==========================================================================
 // MAKE_BUTTON
 // ==========================================================================
@@ -0,0 +1,336 @@
+#include "munin/compact_canvas.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+namespace munin {
+
+namespace {
+
+// Glyph values below this are single-byte glyphs that are stored directly
+// in the cell.  Values from this upwards are indices into the glyph table.
+constexpr std::uint32_t glyph_table_base = 0x100;
+
+// Tables smaller than this are never worth compacting.
+constexpr std::size_t minimum_compaction_size = 256;
+
+// Marks an entry in a table that is not used by any cell.
+constexpr std::uint32_t unused_entry =
+    std::numeric_limits<std::uint32_t>::max();
+
+static_assert(sizeof(compact_canvas::cell) == 8);
+
+// ==========================================================================
+// IS_SIMPLE_GLYPH
+// ==========================================================================
+bool is_simple_glyph(terminalpp::glyph const &gly)
+{
+    return gly == terminalpp::glyph{gly.character_};
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+compact_canvas::compact_canvas(terminalpp::extent size) : size_(size)
+{
+    reset_tables();
+    cells_.resize(
+        static_cast<std::size_t>(size_.width_) * size_.height_,
+        encode(terminalpp::element{}));
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+compact_canvas::compact_canvas(terminalpp::canvas const &cvs)
+{
+    assign(cvs);
+}
+
+// ==========================================================================
+// SIZE
+// ==========================================================================
+terminalpp::extent compact_canvas::size() const
+{
+    return size_;
+}
+
+// ==========================================================================
+// GET
+// ==========================================================================
+terminalpp::element compact_canvas::get(terminalpp::point const &position) const
+{
+    return decode(cells_[index_of(position)]);
+}
+
+// ==========================================================================
+// SET
+// ==========================================================================
+void compact_canvas::set(
+    terminalpp::point const &position, terminalpp::element const &elem)
+{
+    cells_[index_of(position)] = encode(elem);
+}
+
+// ==========================================================================
+// UPDATE
+// ==========================================================================
+bool compact_canvas::update(
+    terminalpp::point const &position, terminalpp::element const &elem)
+{
+    auto &cel = cells_[index_of(position)];
+
+    // Decoding is a pair of lookups, whereas encoding may have to hash the
+    // element, so only encode elements that have actually changed.
+    if (decode(cel) == elem)
+    {
+        return false;
+    }
+
+    cel = encode(elem);
+    return true;
+}
+
+// ==========================================================================
+// ROW
+// ==========================================================================
+std::span<compact_canvas::cell const> compact_canvas::row(
+    terminalpp::coordinate_type row) const
+{
+    return std::span<cell const>{cells_}.subspan(
+        index_of({0, row}), static_cast<std::size_t>(size_.width_));
+}
+
+// ==========================================================================
+// ENCODE
+// ==========================================================================
+void compact_canvas::encode(
+    std::span<terminalpp::element const> elements, std::span<cell> cells)
+{
+    std::ranges::transform(elements, cells.begin(), [this](auto const &elem) {
+        return encode(elem);
+    });
+}
+
+// ==========================================================================
+// STORE
+// ==========================================================================
+void compact_canvas::store(
+    terminalpp::point const &origin, std::span<cell const> cells)
+{
+    std::ranges::copy(cells, cells_.begin() + index_of(origin));
+}
+
+// ==========================================================================
+// ASSIGN
+// ==========================================================================
+void compact_canvas::assign(terminalpp::canvas const &cvs)
+{
+    size_ = cvs.size();
+    reset_tables();
+
+    cells_.clear();
+    cells_.reserve(static_cast<std::size_t>(size_.width_) * size_.height_);
+
+    for (terminalpp::coordinate_type row = 0; row < size_.height_; ++row)
+    {
+        for (terminalpp::coordinate_type column = 0; column < size_.width_;
+             ++column)
+        {
+            cells_.push_back(encode(cvs[column][row]));
+        }
+    }
+}
+
+// ==========================================================================
+// COMPACT
+// ==========================================================================
+void compact_canvas::compact()
+{
+    // Only compacting once the tables have doubled means that the cost of
+    // visiting every cell is spread across at least as many new entries.
+    if (glyphs_.size() + attributes_.size()
+        < (std::max)(2 * compacted_table_size_, minimum_compaction_size))
+    {
+        return;
+    }
+
+    std::vector<std::uint32_t> glyph_remap(glyphs_.size(), unused_entry);
+    std::vector<std::uint32_t> attribute_remap(
+        attributes_.size(), unused_entry);
+    auto old_glyphs = std::move(glyphs_);
+    auto old_attributes = std::move(attributes_);
+
+    reset_tables();
+    attribute_remap[0] = 0;
+
+    for (auto &cel : cells_)
+    {
+        if (cel.glyph_ >= glyph_table_base)
+        {
+            auto &index = glyph_remap[cel.glyph_ - glyph_table_base];
+
+            if (index == unused_entry)
+            {
+                index = static_cast<std::uint32_t>(glyphs_.size());
+                glyphs_.push_back(old_glyphs[cel.glyph_ - glyph_table_base]);
+                glyph_indices_.emplace(glyphs_.back(), index);
+            }
+
+            cel.glyph_ = glyph_table_base + index;
+        }
+
+        auto &index = attribute_remap[cel.attribute_];
+
+        if (index == unused_entry)
+        {
+            index = static_cast<std::uint32_t>(attributes_.size());
+            attributes_.push_back(old_attributes[cel.attribute_]);
+            attribute_indices_.emplace(attributes_.back(), index);
+        }
+
+        cel.attribute_ = index;
+    }
+
+    compacted_table_size_ = glyphs_.size() + attributes_.size();
+}
+
+// ==========================================================================
+// TO_CANVAS
+// ==========================================================================
+terminalpp::canvas compact_canvas::to_canvas() const
+{
+    terminalpp::canvas cvs{size_};
+
+    for (terminalpp::coordinate_type row = 0; row < size_.height_; ++row)
+    {
+        for (terminalpp::coordinate_type column = 0; column < size_.width_;
+             ++column)
+        {
+            cvs[column][row] = get({column, row});
+        }
+    }
+
+    return cvs;
+}
+
+// ==========================================================================
+// PALETTE_SIZE
+// ==========================================================================
+std::size_t compact_canvas::palette_size() const
+{
+    return attributes_.size();
+}
+
+// ==========================================================================
+// GLYPH_TABLE_SIZE
+// ==========================================================================
+std::size_t compact_canvas::glyph_table_size() const
+{
+    return glyphs_.size();
+}
+
+// ==========================================================================
+// HEAP_BYTES
+// ==========================================================================
+std::size_t compact_canvas::heap_bytes() const
+{
+    // Each node of an index holds its entry and a link to the next node,
+    // and each bucket holds a link to a node.
+    auto const index_bytes = [](auto const &index) {
+        using index_entry =
+            typename std::remove_cvref_t<decltype(index)>::value_type;
+
+        return index.bucket_count() * sizeof(void *)
+             + index.size() * (sizeof(index_entry) + sizeof(void *));
+    };
+
+    return cells_.capacity() * sizeof(cell)
+         + glyphs_.capacity() * sizeof(terminalpp::glyph)
+         + attributes_.capacity() * sizeof(terminalpp::attribute)
+         + index_bytes(glyph_indices_) + index_bytes(attribute_indices_);
+}
+
+// ==========================================================================
+// INDEX_OF
+// ==========================================================================
+std::size_t compact_canvas::index_of(terminalpp::point const &position) const
+{
+    return static_cast<std::size_t>(position.y_) * size_.width_ + position.x_;
+}
+
+// ==========================================================================
+// RESET_TABLES
+// ==========================================================================
+void compact_canvas::reset_tables()
+{
+    // The default attribute is always the first entry in the palette, so
+    // that the palette is never empty.
+    glyphs_.clear();
+    glyph_indices_.clear();
+    attributes_.assign(1, terminalpp::attribute{});
+    attribute_indices_.clear();
+    attribute_indices_.emplace(terminalpp::attribute{}, 0);
+    last_attribute_ = 0;
+    compacted_table_size_ = 0;
+}
+
+// ==========================================================================
+// ENCODE
+// ==========================================================================
+compact_canvas::cell compact_canvas::encode(terminalpp::element const &elem)
+{
+    cell result{};
+
+    if (is_simple_glyph(elem.glyph_))
+    {
+        result.glyph_ = elem.glyph_.character_;
+    }
+    else
+    {
+        auto const [glyph, inserted] = glyph_indices_.try_emplace(
+            elem.glyph_, static_cast<std::uint32_t>(glyphs_.size()));
+
+        if (inserted)
+        {
+            glyphs_.push_back(elem.glyph_);
+        }
+
+        result.glyph_ = glyph_table_base + glyph->second;
+    }
+
+    // Runs of cells tend to share an attribute, so the most recently used
+    // attribute is checked before hashing the attribute to look it up.
+    if (attributes_[last_attribute_] != elem.attribute_)
+    {
+        auto const [attribute, inserted] = attribute_indices_.try_emplace(
+            elem.attribute_, static_cast<std::uint32_t>(attributes_.size()));
+
+        if (inserted)
+        {
+            attributes_.push_back(elem.attribute_);
+        }
+
+        last_attribute_ = attribute->second;
+    }
+
+    result.attribute_ = last_attribute_;
+    return result;
+}
+
+// ==========================================================================
+// DECODE
+// ==========================================================================
+terminalpp::element compact_canvas::decode(cell const &cel) const
+{
+    return {
+        cel.glyph_ < glyph_table_base
+            ? terminalpp::glyph{static_cast<terminalpp::byte>(cel.glyph_)}
+            : glyphs_[cel.glyph_ - glyph_table_base],
+        attributes_[cel.attribute_]};
+}
+
+}  // namespace munin
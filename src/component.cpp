@@ -1,8 +1,11 @@
 #include "munin/component.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/render_surface.hpp"
+#include "munin/trace.hpp"
 
 #include <cassert>
+#include <utility>
 
 namespace munin {
 
@@ -11,7 +14,11 @@ namespace munin {
 // ==========================================================================
 void component::set_position(terminalpp::point const &position)
 {
-    do_set_position(position);
+    if (position != get_position())
+    {
+        do_set_position(position);
+        raise_geometry_watches();
+    }
 }
 
 // ==========================================================================
@@ -29,7 +36,50 @@ void component::set_size(terminalpp::extent const &size)
 {
     assert(size.width_ >= 0);
     assert(size.height_ >= 0);
-    do_set_size(size);
+
+    if (size != get_size())
+    {
+        do_set_size(size);
+        raise_geometry_watches();
+    }
+}
+
+// ==========================================================================
+// WATCH_GEOMETRY
+// ==========================================================================
+void component::watch_geometry(geometry_watch &watch)
+{
+    watch.next_ = std::exchange(geometry_watches_, &watch);
+}
+
+// ==========================================================================
+// UNWATCH_GEOMETRY
+// ==========================================================================
+void component::unwatch_geometry(geometry_watch &watch)
+{
+    // A component is rarely watched by more than one container, so the list
+    // is short.
+    for (auto **current = &geometry_watches_; *current != nullptr;
+         current = &(*current)->next_)
+    {
+        if (*current == &watch)
+        {
+            *current = std::exchange(watch.next_, nullptr);
+            return;
+        }
+    }
+}
+
+// ==========================================================================
+// RAISE_GEOMETRY_WATCHES
+// ==========================================================================
+void component::raise_geometry_watches()
+{
+    for (auto const *watch = geometry_watches_; watch != nullptr;
+         watch = watch->next_)
+    {
+        *watch->changed_ = true;
+    }
 }
 
 // ==========================================================================
@@ -112,6 +162,14 @@ void component::set_cursor_position(terminalpp::point const &position)
     do_set_cursor_position(position);
 }
 
+// ==========================================================================
+// IS_OPAQUE
+// ==========================================================================
+bool component::is_opaque() const
+{
+    return do_is_opaque();
+}
+
 // ==========================================================================
 // DRAW
 // ==========================================================================
@@ -126,6 +184,7 @@ void component::draw(render_surface &surface) const
 void component::draw(
     render_surface &surface, terminalpp::rectangle const &region) const
 {
+    MUNIN_TRACE("draw", *this, region);
     do_draw(surface, region);
 }
 
@@ -134,9 +193,28 @@ void component::draw(
 // ==========================================================================
 void component::event(std::any const &ev)
 {
+    MUNIN_TRACE("event", *this);
     do_event(ev);
 }
 
+// ==========================================================================
+// EVENT
+// ==========================================================================
+void component::event(terminalpp::virtual_key const &ev)
+{
+    MUNIN_TRACE("event", *this);
+    do_key_event(ev);
+}
+
+// ==========================================================================
+// EVENT
+// ==========================================================================
+void component::event(terminalpp::mouse::event const &ev)
+{
+    MUNIN_TRACE("event", *this);
+    do_mouse_event(ev);
+}
+
 // ==========================================================================
 // TO_JSON
 // ==========================================================================
@@ -145,4 +223,53 @@ nlohmann::json component::to_json() const
     return do_to_json();
 }
 
+// ==========================================================================
+// CENSUS
+// ==========================================================================
+void component::census(component_census &cen) const
+{
+    auto const &type = typeid(*this);
+
+    cen.add_instance(type);
+    cen.add_signal(type, on_redraw);
+    cen.add_signal(type, on_preferred_size_changed);
+    cen.add_signal(type, on_focus_set);
+    cen.add_signal(type, on_focus_lost);
+    cen.add_signal(type, on_cursor_state_changed);
+    cen.add_signal(type, on_cursor_position_changed);
+
+    do_census(cen);
+}
+
+// ==========================================================================
+// DO_IS_OPAQUE
+// ==========================================================================
+bool component::do_is_opaque() const
+{
+    return false;
+}
+
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void component::do_key_event(terminalpp::virtual_key const &ev)
+{
+    do_event(ev);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void component::do_mouse_event(terminalpp::mouse::event const &ev)
+{
+    do_event(ev);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void component::do_census(component_census & /*cen*/) const
+{
+}
+
 }  // namespace munin
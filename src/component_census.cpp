@@ -0,0 +1,154 @@
+#include "munin/component_census.hpp"
+
+#include <boost/core/demangle.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace munin {
+
+namespace {
+
+// ==========================================================================
+// ENTRY_TO_JSON
+// ==========================================================================
+nlohmann::json entry_to_json(component_census::entry const &ent)
+{
+    return {
+        {"instances",   ent.instances  },
+        {"heap_bytes",  ent.heap_bytes },
+        {"connections", ent.connections}
+    };
+}
+
+}  // namespace
+
+// ==========================================================================
+// ADD_INSTANCE
+// ==========================================================================
+void component_census::add_instance(std::type_info const &type)
+{
+    add(type, entry{1, 0, 0});
+}
+
+// ==========================================================================
+// ADD_HEAP_BYTES
+// ==========================================================================
+void component_census::add_heap_bytes(
+    std::type_info const &type, std::size_t bytes)
+{
+    add(type, entry{0, bytes, 0});
+}
+
+// ==========================================================================
+// TYPES
+// ==========================================================================
+std::map<std::string, component_census::entry> const &
+component_census::types() const
+{
+    return types_;
+}
+
+// ==========================================================================
+// TOTALS
+// ==========================================================================
+component_census::entry const &component_census::totals() const
+{
+    return totals_;
+}
+
+// ==========================================================================
+// TO_JSON
+// ==========================================================================
+nlohmann::json component_census::to_json() const
+{
+    auto types_json = nlohmann::json::object();
+
+    for (auto const &[name, ent] : types_)
+    {
+        types_json[name] = entry_to_json(ent);
+    }
+
+    return {
+        {"types",  std::move(types_json)},
+        {"totals", entry_to_json(totals_)}
+    };
+}
+
+// ==========================================================================
+// ESTIMATE_SIGNAL_BYTES
+// ==========================================================================
+std::size_t component_census::estimate_signal_bytes(std::size_t slots)
+{
+#ifdef MUNIN_WITH_SINGLE_THREADED_SIGNALS
+    // Nothing is allocated until the first slot is connected, when the body
+    // is made with make_shared, which adds a control block of about two
+    // pointers.  The first two slots are held inline in the body.
+    constexpr auto shared_overhead = 2 * sizeof(void *);
+    constexpr std::size_t inline_slots = 2;
+    constexpr auto slot_bytes =
+        sizeof(std::uint64_t) + sizeof(std::function<void()>);
+
+    if (slots == 0)
+    {
+        return 0;
+    }
+
+    return sizeof(detail::single_threaded_signal_body<>) + shared_overhead
+         + (slots > inline_slots ? slots * slot_bytes : 0);
+#else
+    // boost::signals2 keeps its mutex, its shared lists of slots and the
+    // tracking state of each slot in private types whose sizes cannot be
+    // taken here.  These figures are estimates, measured from the
+    // allocations made for a signal with no slots and with one slot, with
+    // Boost 1.74 and libstdc++ on x86-64.  Other platforms and versions of
+    // Boost will differ.
+    constexpr std::size_t measured_signal_bytes = 313;
+    constexpr std::size_t measured_slot_bytes = 272;
+
+    return measured_signal_bytes + slots * measured_slot_bytes;
+#endif
+}
+
+// ==========================================================================
+// ESTIMATE_STRING_BYTES
+// ==========================================================================
+std::size_t component_census::estimate_string_bytes(
+    terminalpp::string const &str)
+{
+    return str.size() * sizeof(terminalpp::element);
+}
+
+// ==========================================================================
+// ESTIMATE_STRING_BYTES
+// ==========================================================================
+std::size_t component_census::estimate_string_bytes(
+    std::vector<terminalpp::string> const &strs)
+{
+    auto bytes = strs.capacity() * sizeof(terminalpp::string);
+
+    for (auto const &str : strs)
+    {
+        bytes += estimate_string_bytes(str);
+    }
+
+    return bytes;
+}
+
+// ==========================================================================
+// ADD
+// ==========================================================================
+void component_census::add(std::type_info const &type, entry const &ent)
+{
+    auto &type_entry = types_[boost::core::demangle(type.name())];
+
+    type_entry.instances += ent.instances;
+    type_entry.heap_bytes += ent.heap_bytes;
+    type_entry.connections += ent.connections;
+
+    totals_.instances += ent.instances;
+    totals_.heap_bytes += ent.heap_bytes;
+    totals_.connections += ent.connections;
+}
+
+}  // namespace munin
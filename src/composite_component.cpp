@@ -1,4 +1,5 @@
 #include <munin/composite_component.hpp>
+#include <munin/component_census.hpp>
 #include <munin/container.hpp>
 
 namespace munin {
@@ -33,6 +34,22 @@ void composite_component::add_component(
     content_.add_component(comp, hint);
 }
 
+// ==========================================================================
+// FORWARD_EVENT
+// ==========================================================================
+void composite_component::forward_event(terminalpp::virtual_key const &event)
+{
+    content_.event(event);
+}
+
+// ==========================================================================
+// FORWARD_EVENT
+// ==========================================================================
+void composite_component::forward_event(terminalpp::mouse::event const &event)
+{
+    content_.event(event);
+}
+
 // ==========================================================================
 // DO_SET_POSITION
 // ==========================================================================
@@ -167,4 +184,13 @@ nlohmann::json composite_component::do_to_json() const
     return content_.to_json().patch(patch);
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void composite_component::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    content_.census(cen);
+}
+
 }  // namespace munin
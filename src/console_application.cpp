@@ -1,4 +1,7 @@
 #include <consolepp/console.hpp>
+#include <munin/background_repaint_scheduler.hpp>
+#include <munin/batching_channel.hpp>
+#include <munin/byte_counting_channel.hpp>
 #include <munin/console_application.hpp>
 #include <munin/window.hpp>
 #include <terminalpp/terminal.hpp>
@@ -32,25 +35,39 @@ struct console_application::impl
       boost::asio::io_context &io_context,
       std::shared_ptr<component> content)
     : console_{io_context},
-      terminal_{console_, behaviour},
+      channel_{console_},
+      batching_channel_{channel_},
+      terminal_{batching_channel_, behaviour},
       window_{terminal_, std::move(content)},
-      canvas_{{console_.size().width, console_.size().height}}
+      canvas_{{console_.size().width, console_.size().height}},
+      scheduler_{io_context.get_executor()}
     {
+        window_.measure_output([this] { return channel_.bytes_written(); });
+        window_.batch_output(
+            [this] { batching_channel_.begin_batch(); },
+            [this] { batching_channel_.end_batch(); });
+
         window_.on_repaint_request.connect(
-            [this] { window_.repaint(canvas_); });
+            [this] { scheduler_.request_repaint(); });
+
+        scheduler_.on_repaint.connect([this] { window_.repaint(canvas_); });
 
         console_.on_size_changed.connect([this] {
             canvas_.resize({console_.size().width, console_.size().height});
-            window_.repaint(canvas_);
+            scheduler_.request_repaint();
         });
 
         schedule_read(terminal_, window_);
     }
 
     consolepp::console console_;
+    byte_counting_channel<consolepp::console> channel_;
+    batching_channel<byte_counting_channel<consolepp::console>>
+        batching_channel_;
     terminalpp::terminal terminal_;
     window window_;
     terminalpp::canvas canvas_;
+    background_repaint_scheduler scheduler_;
 };
 
 // ==========================================================================
@@ -77,4 +94,13 @@ terminalpp::terminal &console_application::terminal()
     return pimpl_->terminal_;
 }
 
+// ==========================================================================
+// CONSOLE_APPLICATION::SET_FRAME_INTERVAL
+// ==========================================================================
+void console_application::set_frame_interval(
+    std::chrono::steady_clock::duration const interval)
+{
+    pimpl_->scheduler_.set_frame_interval(interval);
+}
+
 }  // namespace munin
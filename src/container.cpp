@@ -1,25 +1,371 @@
 #include "munin/container.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/detail/algorithm.hpp"
 #include "munin/detail/json_adaptors.hpp"
+#include "munin/detail/spatial_index.hpp"
 #include "munin/layout.hpp"
 #include "munin/null_layout.hpp"
+#include "munin/redraw_transaction.hpp"
+#include "munin/region.hpp"
 #include "munin/render_surface.hpp"
 
 #include <boost/scope_exit.hpp>
 #include <terminalpp/mouse.hpp>
 #include <terminalpp/rectangle.hpp>
+#include <terminalpp/virtual_key.hpp>
 
 #include <algorithm>
+#include <cassert>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <ranges>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace munin {
 
 namespace {
 
-using component_connections = std::vector<boost::signals2::connection>;
+using component_connections = std::vector<connection>;
+
+// ==========================================================================
+// SUBCOMPONENT_LINK
+// ==========================================================================
+// A subcomponent's link to its place in a container.  The slots that the
+// container connects to the subcomponent's signals refer to its link, so
+// that notifications from the subcomponent arrive with the subcomponent
+// and its index at hand, without having to lock a weak_ptr or search for
+// it.  Links are allocated individually so that they stay put when the
+// container's arrays are compacted.
+//
+// The link shares ownership of the subcomponent, and gives it up when the
+// subcomponent is removed.  It also holds the watch through which the
+// subcomponent reports changes to its position and size.
+struct subcomponent_link
+{
+    std::shared_ptr<component> component_;
+    std::size_t index_;
+    geometry_watch geometry_watch_;
+};
+
+// ==========================================================================
+// SUBCOMPONENTS
+// ==========================================================================
+// The subcomponents of a container, together with their layout hints and
+// the connections made to their signals.  The components and hints are kept
+// in separate arrays because that is the form in which layouts use them.
+//
+// Removing a subcomponent finds it through an index rather than a search,
+// and only disconnects it and leaves its entry vacant, which takes constant
+// time.  If the subcomponent is removed while a notification from any
+// subcomponent is being handled, then it may be the one that sent it, so
+// it is kept alive until the handling is complete.  Vacant entries are swept
+// away in a single pass the next time the arrays are used, which costs time
+// in proportion to the number of entries after the first vacancy, so that
+// removing many subcomponents in succession does not shuffle the arrays
+// each time.
+class subcomponents
+{
+public:
+    // ======================================================================
+    // NOTIFICATION
+    // ======================================================================
+    // A guard that marks that a notification from a subcomponent is being
+    // handled for as long as it lives.  This costs much less than taking a
+    // share of the subcomponent for each notification.
+    class notification
+    {
+    public:
+        explicit notification(subcomponents &subs) : subs_(subs)
+        {
+            ++subs_.notifications_;
+        }
+
+        ~notification()
+        {
+            if (--subs_.notifications_ == 0 && !subs_.removed_.empty())
+            {
+                // Subcomponents are released from a local vector, since
+                // their destructors could remove yet more subcomponents.
+                auto const removed = std::exchange(subs_.removed_, {});
+            }
+        }
+
+        notification(notification const &) = delete;
+        notification &operator=(notification const &) = delete;
+
+    private:
+        subcomponents &subs_;
+    };
+
+    // ======================================================================
+    // CONSTRUCTOR
+    // ======================================================================
+    subcomponents() = default;
+    subcomponents(subcomponents const &) = delete;
+    subcomponents &operator=(subcomponents const &) = delete;
+
+    // ======================================================================
+    // DESTRUCTOR
+    // ======================================================================
+    // Subcomponents may outlive their container, and so must be detached
+    // from it before it goes.
+    ~subcomponents()
+    {
+        clear();
+    }
+
+    // ======================================================================
+    // ADD
+    // ======================================================================
+    template <class Connect>
+    void add(std::shared_ptr<component> comp, std::any hint, Connect &&connect)
+    {
+        auto link = std::make_unique<subcomponent_link>(
+            subcomponent_link{comp, components_.size(), {}});
+
+        connections_.push_back(std::forward<Connect>(connect)(*link));
+        positions_.emplace(comp.get(), components_.size());
+        components_.push_back(std::move(comp));
+        hints_.push_back(std::move(hint));
+        links_.push_back(std::move(link));
+    }
+
+    // ======================================================================
+    // REMOVE
+    // ======================================================================
+    bool remove(component const *comp)
+    {
+        auto const [first, last] = positions_.equal_range(comp);
+
+        if (first == last)
+        {
+            return false;
+        }
+
+        for (auto const &[_, index] : std::ranges::subrange(first, last))
+        {
+            disconnect(connections_[index]);
+            unwatch(*links_[index]);
+            components_[index] = nullptr;
+            release(std::move(links_[index]->component_));
+            hints_[index].reset();
+            ++vacancies_;
+        }
+
+        positions_.erase(first, last);
+        return true;
+    }
+
+    // ======================================================================
+    // CLEAR
+    // ======================================================================
+    void clear()
+    {
+        std::ranges::for_each(connections_, disconnect);
+
+        for (auto const &link : links_)
+        {
+            if (link->component_ != nullptr)
+            {
+                unwatch(*link);
+                release(std::move(link->component_));
+            }
+        }
+
+        components_.clear();
+        hints_.clear();
+        connections_.clear();
+        links_.clear();
+        positions_.clear();
+        vacancies_ = 0;
+    }
+
+    // ======================================================================
+    // COMPONENTS
+    // ======================================================================
+    [[nodiscard]] std::vector<std::shared_ptr<component>> const &components()
+        const
+    {
+        sweep();
+        return components_;
+    }
+
+    // ======================================================================
+    // HINTS
+    // ======================================================================
+    [[nodiscard]] std::vector<std::any> const &hints() const
+    {
+        sweep();
+        return hints_;
+    }
+
+    // ======================================================================
+    // INDEX_OF
+    // ======================================================================
+    [[nodiscard]] std::optional<std::size_t> index_of(
+        component const *comp) const
+    {
+        sweep();
+
+        auto const position = positions_.find(comp);
+        return position == positions_.end()
+                 ? std::nullopt
+                 : std::optional<std::size_t>{position->second};
+    }
+
+    // ======================================================================
+    // LOCATE
+    // ======================================================================
+    // Returns the index of a subcomponent that was last known to be at the
+    // given index, which is preferred if the subcomponent is still there, in
+    // case it was added more than once.
+    [[nodiscard]] std::optional<std::size_t> locate(
+        component const *comp, std::size_t last_known_index) const
+    {
+        sweep();
+
+        if (last_known_index < components_.size()
+            && components_[last_known_index].get() == comp)
+        {
+            return last_known_index;
+        }
+
+        return index_of(comp);
+    }
+
+    // ======================================================================
+    // HEAP_BYTES
+    // ======================================================================
+    [[nodiscard]] std::size_t heap_bytes() const
+    {
+        // Each node of the position map holds its entry and a link to the
+        // next node.
+        using position_entry = decltype(positions_)::value_type;
+
+        auto bytes =
+            components_.capacity() * sizeof(std::shared_ptr<component>)
+            + hints_.capacity() * sizeof(std::any)
+            + connections_.capacity() * sizeof(component_connections)
+            + links_.capacity() * sizeof(std::unique_ptr<subcomponent_link>)
+            + links_.size() * sizeof(subcomponent_link)
+            + removed_.capacity() * sizeof(std::shared_ptr<component>)
+            + positions_.bucket_count() * sizeof(void *)
+            + positions_.size() * (sizeof(position_entry) + sizeof(void *));
+
+        for (auto const &cnx : connections_)
+        {
+            bytes += cnx.capacity() * sizeof(connection);
+        }
+
+        return bytes;
+    }
+
+private:
+    // ======================================================================
+    // RELEASE
+    // ======================================================================
+    void release(std::shared_ptr<component> comp)
+    {
+        if (notifications_ != 0 && comp != nullptr)
+        {
+            removed_.push_back(std::move(comp));
+        }
+    }
+
+    // ======================================================================
+    // UNWATCH
+    // ======================================================================
+    static void unwatch(subcomponent_link &link)
+    {
+        link.component_->unwatch_geometry(link.geometry_watch_);
+    }
+
+    // ======================================================================
+    // DISCONNECT
+    // ======================================================================
+    static void disconnect(component_connections &connections)
+    {
+        for (auto &cnx : connections)
+        {
+            cnx.disconnect();
+        }
+    }
+
+    // ======================================================================
+    // MOVE_POSITION
+    // ======================================================================
+    void move_position(
+        component const *comp, std::size_t from, std::size_t to) const
+    {
+        // A component added more than once has one position per entry, so
+        // the one for this entry must be picked out.
+        auto const [first, last] = positions_.equal_range(comp);
+        auto const position = std::ranges::find(
+            std::ranges::subrange(first, last),
+            from,
+            [](auto const &entry) { return entry.second; });
+
+        position->second = to;
+    }
+
+    // ======================================================================
+    // SWEEP
+    // ======================================================================
+    void sweep() const
+    {
+        if (vacancies_ == 0)
+        {
+            return;
+        }
+
+        // Entries before the first vacancy stay where they are, so neither
+        // they nor their positions need to be touched.
+        auto occupied = static_cast<std::size_t>(std::distance(
+            components_.begin(), std::ranges::find(components_, nullptr)));
+
+        for (auto index = occupied; index < components_.size(); ++index)
+        {
+            if (components_[index] == nullptr)
+            {
+                continue;
+            }
+
+            move_position(components_[index].get(), index, occupied);
+            components_[occupied] = std::move(components_[index]);
+            hints_[occupied] = std::move(hints_[index]);
+            connections_[occupied] = std::move(connections_[index]);
+            links_[occupied] = std::move(links_[index]);
+            links_[occupied]->index_ = occupied;
+            ++occupied;
+        }
+
+        components_.resize(occupied);
+        hints_.resize(occupied);
+        connections_.resize(occupied);
+        links_.resize(occupied);
+        vacancies_ = 0;
+    }
+
+    mutable std::vector<std::shared_ptr<component>> components_;
+    mutable std::vector<std::any> hints_;
+    mutable std::vector<component_connections> connections_;
+    mutable std::vector<std::unique_ptr<subcomponent_link>> links_;
+    mutable std::unordered_multimap<component const *, std::size_t>
+        positions_;
+    mutable std::size_t vacancies_ = 0;
+    std::vector<std::shared_ptr<component>> removed_;
+    int notifications_ = 0;
+};
+
+// Containers with fewer subcomponents than this are simply searched
+// linearly, since building and maintaining a spatial index would cost more
+// than it saves.
+constexpr std::size_t spatial_index_threshold = 32;
 
 auto find_first_focussed_component(std::ranges::forward_range auto const &rng)
 {
@@ -69,6 +415,11 @@ struct container::impl
     // ======================================================================
     explicit impl(container &self) : self_(self)
     {
+        // The cached preferred size is discarded whenever the preferred
+        // size is announced to have changed.  This is connected first so
+        // that any other observers see the new size.
+        self_.on_preferred_size_changed.connect(
+            [this] { preferred_size_.reset(); });
     }
 
     // ======================================================================
@@ -77,7 +428,8 @@ struct container::impl
     void set_layout(std::unique_ptr<munin::layout> &&lyt)
     {
         layout_ = lyt == nullptr ? make_null_layout() : std::move(lyt);
-        layout_container();
+        preferred_size_.reset();
+        invalidate_layout();
     }
 
     // ======================================================================
@@ -86,36 +438,9 @@ struct container::impl
     void add_component(
         std::shared_ptr<component> const &comp, std::any const &layout_hint)
     {
-        component_connections cnx;
-
-        cnx.push_back(comp->on_focus_set.connect(
-            [this, wcomp = std::weak_ptr<component>(comp)] {
-                this->subcomponent_focus_set_handler(wcomp);
-            }));
-
-        cnx.push_back(comp->on_focus_lost.connect(
-            [this] { this->subcomponent_focus_lost_handler(); }));
-
-        cnx.push_back(comp->on_cursor_state_changed.connect(
-            [this, wcomp = std::weak_ptr<component>(comp)] {
-                this->subcomponent_cursor_state_change_handler(wcomp);
-            }));
-
-        cnx.push_back(comp->on_cursor_position_changed.connect(
-            [this, wcomp = std::weak_ptr<component>(comp)] {
-                this->subcomponent_cursor_position_change_handler(wcomp);
-            }));
-
-        cnx.push_back(comp->on_redraw.connect(
-            [this, wcomp = std::weak_ptr<component>(comp)](
-                auto const &redraw_regions) {
-                this->subcomponent_redraw_handler(wcomp, redraw_regions);
-            }));
-
-        components_.push_back(comp);
-        hints_.push_back(layout_hint);
-        component_connections_.push_back(cnx);
-        layout_container();
+        attach_component(comp, layout_hint);
+        spatial_index_dirty_ = true;
+        invalidate_layout();
         self_.on_preferred_size_changed();
     }
 
@@ -124,23 +449,37 @@ struct container::impl
     // ======================================================================
     void remove_component(std::shared_ptr<component> const &comp)
     {
-        auto const &disconnect_connection = [](auto &cnx) { cnx.disconnect(); };
-
-        for (auto index = 0; index < components_.size(); ++index)
+        if (subcomponents_.remove(comp.get()))
         {
-            if (components_[index] == comp)
-            {
-                components_.erase(components_.begin() + index);
-                hints_.erase(hints_.begin() + index);
-                std::ranges::for_each(
-                    component_connections_[index], disconnect_connection);
+            // Removal moves the subcomponents that follow it.
+            focussed_index_.reset();
+            spatial_index_dirty_ = true;
+            invalidate_layout();
+            self_.on_preferred_size_changed();
+        }
+    }
 
-                component_connections_.erase(
-                    component_connections_.begin() + index);
-            }
+    // ======================================================================
+    // REPLACE_COMPONENTS
+    // ======================================================================
+    void replace_components(
+        std::vector<std::shared_ptr<component>> const &comps,
+        std::vector<std::any> const &layout_hints)
+    {
+        assert(layout_hints.empty() || layout_hints.size() == comps.size());
+
+        subcomponents_.clear();
+        focussed_index_.reset();
+
+        for (auto index = size_t{0}; index < comps.size(); ++index)
+        {
+            attach_component(
+                comps[index],
+                layout_hints.empty() ? std::any{} : layout_hints[index]);
         }
 
-        layout_container();
+        spatial_index_dirty_ = true;
+        invalidate_layout();
         self_.on_preferred_size_changed();
     }
 
@@ -166,7 +505,7 @@ struct container::impl
     void set_size(terminalpp::extent const &size)
     {
         bounds_.size_ = size;
-        layout_container();
+        invalidate_layout();
     }
 
     // ======================================================================
@@ -182,7 +521,16 @@ struct container::impl
     // ======================================================================
     [[nodiscard]] terminalpp::extent get_preferred_size() const
     {
-        return layout_->get_preferred_size(components_, hints_);
+        // Calculating the preferred size usually means asking every
+        // subcomponent for its preferred size in turn, so it is only done
+        // when something has changed since it was last asked for.
+        if (!preferred_size_)
+        {
+            preferred_size_ = layout_->get_preferred_size(
+                components(), subcomponents_.hints());
+        }
+
+        return *preferred_size_;
     }
 
     // ==========================================================================
@@ -213,9 +561,12 @@ struct container::impl
             };
 
             auto const &focussed_component =
-                increment_focus(components_, set_component_focus);
+                increment_focus(components(), set_component_focus);
 
-            has_focus_ = focussed_component != components_.end();
+            has_focus_ = focussed_component != components().end();
+            focussed_index_ =
+                has_focus_ ? subcomponents_.index_of(focussed_component->get())
+                           : std::nullopt;
 
             if (has_focus_)
             {
@@ -238,11 +589,11 @@ struct container::impl
             in_focus_operation_ = false;
         };
 
-        if (auto focussed_component =
-                find_first_focussed_component(components_);
-            focussed_component != components_.end())
+        if (auto const focussed_component = find_focussed_component();
+            focussed_component)
         {
-            (*focussed_component)->lose_focus();
+            focussed_component->lose_focus();
+            focussed_index_.reset();
             has_focus_ = false;
             self_.on_focus_lost();
             self_.on_cursor_state_changed();
@@ -260,7 +611,7 @@ struct container::impl
             return comp->has_focus();
         };
 
-        focus_incremental(components_, focus_next_component);
+        focus_incremental(components(), focus_next_component);
     }
 
     // ======================================================================
@@ -274,7 +625,7 @@ struct container::impl
         };
 
         focus_incremental(
-            components_ | std::views::reverse, focus_previous_component);
+            components() | std::views::reverse, focus_previous_component);
     }
 
     // ======================================================================
@@ -282,9 +633,9 @@ struct container::impl
     // ======================================================================
     [[nodiscard]] bool get_cursor_state() const
     {
-        auto comp = find_first_focussed_component(components_);
+        auto const comp = find_focussed_component();
 
-        return comp == components_.end() ? false : (*comp)->get_cursor_state();
+        return comp ? comp->get_cursor_state() : false;
     }
 
     // ======================================================================
@@ -292,11 +643,12 @@ struct container::impl
     // ======================================================================
     [[nodiscard]] terminalpp::point get_cursor_position() const
     {
-        auto comp = find_first_focussed_component(components_);
+        ensure_laid_out();
+
+        auto const comp = find_focussed_component();
 
-        return comp == components_.end()
-                 ? terminalpp::point{}
-                 : (*comp)->get_position() + (*comp)->get_cursor_position();
+        return comp ? comp->get_position() + comp->get_cursor_position()
+                    : terminalpp::point{};
     }
 
     // ======================================================================
@@ -308,11 +660,11 @@ struct container::impl
         // make too much sense, but an implementation is required to fulfil the
         // component interface.  Our default implementation sets the relative
         // cursor position in the focussed component.
-        auto comp = find_first_focussed_component(components_);
+        ensure_laid_out();
 
-        if (comp != components_.end())
+        if (auto const comp = find_focussed_component(); comp)
         {
-            (*comp)->set_cursor_position(position - (*comp)->get_position());
+            comp->set_cursor_position(position - comp->get_position());
         }
     }
 
@@ -322,9 +674,31 @@ struct container::impl
     void draw(
         render_surface &surface, terminalpp::rectangle const &region) const
     {
-        for (auto const &comp : components_)
+        // Any pending layout must be performed before the subcomponents are
+        // drawn.  Since they are drawn after this, any containers among
+        // them are laid out from the top of the tree downward.
+        ensure_laid_out();
+
+        auto const candidates = components_in(region);
+
+        // A component can only be hidden by a component that is drawn after
+        // it.  If there are no such opaque components, then there is nothing
+        // to cull.
+        auto const is_opaque = [this](auto const index) {
+            return components()[index]->is_opaque();
+        };
+
+        if (candidates.size() > 1
+            && std::any_of(candidates.begin() + 1, candidates.end(), is_opaque))
         {
-            draw_component(comp, surface, region);
+            draw_unoccluded(candidates, surface, region);
+        }
+        else
+        {
+            for (auto const index : candidates)
+            {
+                draw_component(components()[index], surface, region);
+            }
         }
     }
 
@@ -339,23 +713,47 @@ struct container::impl
         // * Mouse events are passed on to the subcomponent at the location
         //   of the event, and the co-ordinates of the event are passed on
         //   relative to the subcomponent's location.
-        if (auto const *mouse_event =
-                std::any_cast<terminalpp::mouse::event>(&ev);
-            mouse_event == nullptr)
+        // Keypresses and mouse events are unboxed here, so that they can be
+        // passed further down the tree without being boxed again.
+        if (auto const *mouse = std::any_cast<terminalpp::mouse::event>(&ev);
+            mouse != nullptr)
         {
-            handle_common_event(ev);
+            handle_mouse_event(*mouse);
+        }
+        else if (auto const *vk = std::any_cast<terminalpp::virtual_key>(&ev);
+                 vk != nullptr)
+        {
+            handle_common_event(*vk);
         }
         else
         {
-            handle_mouse_event(*mouse_event);
+            handle_common_event(ev);
         }
     }
 
+    // ======================================================================
+    // KEY_EVENT
+    // ======================================================================
+    void key_event(terminalpp::virtual_key const &vk)
+    {
+        handle_common_event(vk);
+    }
+
+    // ======================================================================
+    // MOUSE_EVENT
+    // ======================================================================
+    void mouse_event(terminalpp::mouse::event const &ev)
+    {
+        handle_mouse_event(ev);
+    }
+
     // ======================================================================
     // TO_JSON
     // ======================================================================
     [[nodiscard]] nlohmann::json to_json() const
     {
+        ensure_laid_out();
+
         nlohmann::json json = {
             {"type",            "container"                           },
             {"position",        detail::to_json(get_position())       },
@@ -369,21 +767,337 @@ struct container::impl
 
         auto &subcomponents = json["subcomponents"];
 
-        for (auto index = size_t{0}; index < components_.size(); ++index)
+        for (auto index = size_t{0}; index < components().size(); ++index)
         {
-            subcomponents[index] = components_[index]->to_json();
+            subcomponents[index] = components()[index]->to_json();
         }
 
         return json;
     }
 
+    // ======================================================================
+    // CENSUS
+    // ======================================================================
+    void census(component_census &cen) const
+    {
+        cen.add_heap_bytes(
+            typeid(container),
+            sizeof(*this) + subcomponents_.heap_bytes()
+                + spatial_index_.heap_bytes());
+
+        auto const &lyt = *layout_;
+        cen.add_instance(typeid(lyt));
+
+        for (auto const &comp : components())
+        {
+            comp->census(cen);
+        }
+    }
+
 private:
+    // ======================================================================
+    // COMPONENTS
+    // ======================================================================
+    [[nodiscard]] std::vector<std::shared_ptr<component>> const &components()
+        const
+    {
+        return subcomponents_.components();
+    }
+
+    // ======================================================================
+    // FIND_FOCUSSED_COMPONENT
+    // ======================================================================
+    [[nodiscard]] std::shared_ptr<component> find_focussed_component() const
+    {
+        // The index of the focussed subcomponent is remembered when the
+        // focus moves, so that events and cursor queries do not have to ask
+        // every subcomponent whether it has focus.  It is still checked,
+        // since a subcomponent can gain or lose focus without it passing
+        // through this container.
+        auto const &comps = components();
+
+        if (focussed_index_ && *focussed_index_ < comps.size()
+            && comps[*focussed_index_]->has_focus())
+        {
+            return comps[*focussed_index_];
+        }
+
+        auto const comp = find_first_focussed_component(comps);
+
+        if (comp == comps.end())
+        {
+            focussed_index_.reset();
+            return nullptr;
+        }
+
+        focussed_index_ = static_cast<std::size_t>(comp - comps.begin());
+        return *comp;
+    }
+
+    // ======================================================================
+    // FIND_OTHER_FOCUSSED_COMPONENT
+    // ======================================================================
+    [[nodiscard]] std::shared_ptr<component> find_other_focussed_component(
+        component const &subcomponent) const
+    {
+        // The remembered subcomponent is tried first, but the index may have
+        // been forgotten (for example, when a subcomponent was removed), in
+        // which case the search must skip the subcomponent that has just
+        // gained focus, or it may find that one instead of the one that
+        // held the focus before it.
+        auto const &comps = components();
+
+        if (focussed_index_ && *focussed_index_ < comps.size()
+            && comps[*focussed_index_].get() != &subcomponent
+            && comps[*focussed_index_]->has_focus())
+        {
+            return comps[*focussed_index_];
+        }
+
+        auto const &another_component_has_focus =
+            [&subcomponent](auto const &comp) {
+                return comp.get() != &subcomponent && comp->has_focus();
+            };
+
+        auto const comp =
+            std::ranges::find_if(comps, another_component_has_focus);
+
+        return comp == comps.end() ? nullptr : *comp;
+    }
+
+    // ======================================================================
+    // ATTACH_COMPONENT
+    // ======================================================================
+    void attach_component(
+        std::shared_ptr<component> const &comp, std::any const &layout_hint)
+    {
+        subcomponents_.add(
+            comp, layout_hint, [this](subcomponent_link &link) {
+                return connect_subcomponent(link);
+            });
+    }
+
+    // ======================================================================
+    // CONNECT_SUBCOMPONENT
+    // ======================================================================
+    component_connections connect_subcomponent(subcomponent_link &link)
+    {
+        // Slots that use the subcomponent mark that a notification is being
+        // handled before doing anything else, since whatever they call may
+        // remove it from the container, and it must not be destroyed until
+        // they have finished with it.  The link itself is freed when the
+        // subcomponent is swept away, so the slots pass on copies of what
+        // they need from it rather than the link.
+        auto &comp = *link.component_;
+        component_connections cnx;
+
+        // The subcomponent may be moved or resized by something other than
+        // the layout, which must also cause the spatial index to be rebuilt.
+        link.geometry_watch_.changed_ = &spatial_index_dirty_;
+        comp.watch_geometry(link.geometry_watch_);
+
+        cnx.push_back(comp.on_focus_set.connect([this, &link] {
+            subcomponents::notification const notifying{subcomponents_};
+            this->subcomponent_focus_set_handler(
+                *link.component_, link.index_);
+        }));
+
+        cnx.push_back(comp.on_focus_lost.connect(
+            [this] { this->subcomponent_focus_lost_handler(); }));
+
+        cnx.push_back(comp.on_cursor_state_changed.connect([this, &link] {
+            subcomponents::notification const notifying{subcomponents_};
+            this->subcomponent_cursor_state_change_handler(*link.component_);
+        }));
+
+        cnx.push_back(comp.on_cursor_position_changed.connect([this, &link] {
+            subcomponents::notification const notifying{subcomponents_};
+            this->subcomponent_cursor_position_change_handler(
+                *link.component_);
+        }));
+
+        cnx.push_back(comp.on_preferred_size_changed.connect(
+            [this] { self_.on_preferred_size_changed(); }));
+
+        cnx.push_back(comp.on_redraw.connect(
+            [this, &link](auto const &redraw_regions) {
+                subcomponents::notification const notifying{
+                    subcomponents_};
+                this->subcomponent_redraw_handler(
+                    *link.component_, redraw_regions);
+            }));
+
+        return cnx;
+    }
+
+    // ======================================================================
+    // INVALIDATE_LAYOUT
+    // ======================================================================
+    void invalidate_layout()
+    {
+        // While a transaction is open, the layout is postponed until it
+        // closes, or until the layout is needed, whichever is sooner.  This
+        // means that any number of changes within the transaction cost only
+        // one layout.
+        if (redraw_transaction::is_open())
+        {
+            defer_layout();
+        }
+        else
+        {
+            pending_layout_ = nullptr;
+            layout_container();
+        }
+    }
+
+    // ======================================================================
+    // DEFER_LAYOUT
+    // ======================================================================
+    void defer_layout()
+    {
+        if (!pending_layout_)
+        {
+            pending_layout_ = std::make_shared<bool>(true);
+
+            // As with deferred redraws, the pending layout is owned by this
+            // container, so if it has expired by the time the transaction
+            // closes, then either the container has been destroyed or the
+            // layout has already been performed.
+            redraw_transaction::defer_layout(
+                [this, weak_pending = std::weak_ptr(pending_layout_)] {
+                    if (weak_pending.lock())
+                    {
+                        this->ensure_laid_out();
+                    }
+                });
+        }
+    }
+
+    // ======================================================================
+    // ENSURE_LAID_OUT
+    // ======================================================================
+    void ensure_laid_out() const
+    {
+        if (pending_layout_)
+        {
+            pending_layout_ = nullptr;
+            layout_container();
+        }
+    }
+
     // ======================================================================
     // LAYOUT_CONTAINER
     // ======================================================================
-    void layout_container()
+    void layout_container() const
+    {
+        // Any subcomponents that are moved or resized by the layout raise
+        // their geometry watches, which marks the spatial index for
+        // rebuilding.
+        (*layout_)(components(), subcomponents_.hints(), bounds_.size_);
+    }
+
+    // ======================================================================
+    // USES_SPATIAL_INDEX
+    // ======================================================================
+    [[nodiscard]] bool uses_spatial_index() const
     {
-        (*layout_)(components_, hints_, bounds_.size_);
+        return components().size() >= spatial_index_threshold;
+    }
+
+    // ======================================================================
+    // GET_SPATIAL_INDEX
+    // ======================================================================
+    detail::spatial_index const &get_spatial_index() const
+    {
+        // The index is rebuilt lazily, so that adding, moving or resizing
+        // many components in succession does not rebuild it each time.
+        if (spatial_index_dirty_)
+        {
+            std::vector<terminalpp::rectangle> bounds;
+            bounds.reserve(components().size());
+
+            for (auto const &comp : components())
+            {
+                bounds.emplace_back(comp->get_position(), comp->get_size());
+            }
+
+            spatial_index_.rebuild(bounds);
+            spatial_index_dirty_ = false;
+        }
+
+        return spatial_index_;
+    }
+
+    // ======================================================================
+    // COMPONENTS_IN
+    // ======================================================================
+    [[nodiscard]] std::vector<std::size_t> components_in(
+        terminalpp::rectangle const &region) const
+    {
+        if (uses_spatial_index())
+        {
+            return get_spatial_index().query(region);
+        }
+
+        std::vector<std::size_t> indices(components().size());
+        std::iota(indices.begin(), indices.end(), std::size_t{0});
+        return indices;
+    }
+
+    // ======================================================================
+    // DRAW_UNOCCLUDED
+    // ======================================================================
+    void draw_unoccluded(
+        std::vector<std::size_t> const &candidates,
+        render_surface &surface,
+        terminalpp::rectangle const &region) const
+    {
+        // Work from the topmost component down, removing the bounds of each
+        // opaque component from the region that is still visible to the
+        // components beneath it.
+        std::vector<munin::region> visible_regions(candidates.size());
+        munin::region uncovered{region};
+
+        for (auto index = candidates.size();
+             index-- > 0 && !uncovered.empty();)
+        {
+            auto const &comp = components()[candidates[index]];
+            auto const bounds =
+                terminalpp::rectangle{comp->get_position(), comp->get_size()};
+
+            visible_regions[index] = uncovered & bounds;
+
+            if (comp->is_opaque())
+            {
+                uncovered -= bounds;
+            }
+        }
+
+        // Then draw from the bottom up, so that any overlapping transparent
+        // components are still drawn in the correct order.
+        for (auto index = size_t{0}; index < candidates.size(); ++index)
+        {
+            for (auto const &rect : visible_regions[index].rectangles())
+            {
+                draw_component(components()[candidates[index]], surface, rect);
+            }
+        }
+    }
+
+    // ======================================================================
+    // FIND_COMPONENT_AT
+    // ======================================================================
+    [[nodiscard]] std::shared_ptr<component> find_component_at(
+        terminalpp::point const &location) const
+    {
+        if (uses_spatial_index())
+        {
+            auto const index = get_spatial_index().find(location);
+            return index ? components()[*index] : nullptr;
+        }
+
+        auto const comp = find_component_at_point(components(), location);
+        return comp == components().end() ? nullptr : *comp;
     }
 
     // ======================================================================
@@ -417,6 +1131,10 @@ private:
             std::forward<Op>(increment_op));
 
         has_focus_ = incrementally_focussed_component != cend(components);
+        focussed_index_ = has_focus_
+                            ? subcomponents_.index_of(
+                                  incrementally_focussed_component->get())
+                            : std::nullopt;
 
         // Announce a change in focus if that changed.
         if (had_focus != has_focus_)
@@ -458,7 +1176,13 @@ private:
         auto const component_region =
             terminalpp::rectangle{comp->get_position(), comp->get_size()};
 
-        if (auto draw_region = detail::intersection(component_region, region);
+        // The component may not draw outside of its own bounds.  Since the
+        // surface may already be clipped, this can also mean that none of
+        // it can be seen, in which case it need not be drawn at all.
+        render_surface::scoped_clip const clip{surface, component_region};
+
+        if (auto draw_region =
+                detail::intersection(surface.clip_rect(), region);
             draw_region)
         {
             // The draw region is currently relative to this container's
@@ -488,27 +1212,66 @@ private:
     // SUBCOMPONENT_REDRAW_HANDLER
     // ======================================================================
     void subcomponent_redraw_handler(
-        std::weak_ptr<component> const &weak_subcomponent,
-        std::vector<terminalpp::rectangle> regions)
+        component const &subcomponent,
+        std::vector<terminalpp::rectangle> const &regions)
     {
-        auto subcomponent = weak_subcomponent.lock();
+        // Merge the regions so that any overlaps are removed before
+        // they are passed further up the tree.
+        region damage{regions};
+
+        // Each region is bound to the origin of the component in question.
+        // It must be rebound to the origin of the container.  We do this
+        // by offsetting the regions' origins by the origin of the
+        // subcomponent within this container.
+        damage.translate(subcomponent.get_position());
+
+        // This new information must be passed up the component heirarchy,
+        // either now or, if a redraw transaction is open, once all of the
+        // redraws in the transaction have been gathered together.
+        if (redraw_transaction::is_open())
+        {
+            defer_redraw(damage);
+        }
+        else
+        {
+            self_.on_redraw(damage.rectangles());
+        }
+    }
 
-        if (subcomponent != nullptr)
+    // ======================================================================
+    // DEFER_REDRAW
+    // ======================================================================
+    void defer_redraw(munin::region const &damage)
+    {
+        if (!pending_redraw_)
         {
-            // Each region is bound to the origin of the component in question.
-            // It must be rebound to the origin of the container.  We do this
-            // by offsetting the regions' origins by the origin of the
-            // subcomponent within this container.
-            auto origin = subcomponent->get_position();
+            pending_redraw_ = std::make_shared<munin::region>();
+
+            // The pending redraw is owned by this container, so if it has
+            // been destroyed by the time the transaction closes, then so has
+            // the container.
+            redraw_transaction::defer(
+                [this, weak_pending = std::weak_ptr(pending_redraw_)] {
+                    if (weak_pending.lock())
+                    {
+                        this->flush_pending_redraw();
+                    }
+                });
+        }
 
-            for (auto &rect : regions)
-            {
-                rect.origin_.x_ += origin.x_;
-                rect.origin_.y_ += origin.y_;
-            }
+        *pending_redraw_ |= damage;
+    }
 
-            // This new information must be passed up the component heirarchy.
-            self_.on_redraw(regions);
+    // ======================================================================
+    // FLUSH_PENDING_REDRAW
+    // ======================================================================
+    void flush_pending_redraw()
+    {
+        auto const pending_redraw = std::exchange(pending_redraw_, nullptr);
+
+        if (!pending_redraw->empty())
+        {
+            self_.on_redraw(pending_redraw->rectangles());
         }
     }
 
@@ -516,18 +1279,14 @@ private:
     // SUBCOMPONENT_FOCUS_SET_HANDLER
     // ======================================================================
     void subcomponent_focus_set_handler(
-        std::weak_ptr<component> const &weak_comp)
+        component const &subcomponent, std::size_t last_known_index)
     {
         if (!in_focus_operation_)
         {
-            auto const &another_component_has_focus =
-                [orig = weak_comp.lock()](auto const &comp) {
-                    return comp != orig && comp->has_focus();
-                };
+            // If another subcomponent had the focus, then it must lose it.
+            auto const comp = find_other_focussed_component(subcomponent);
 
-            if (auto comp = std::ranges::find_if(
-                    components_, another_component_has_focus);
-                comp != components_.end())
+            if (comp)
             {
                 in_focus_operation_ = true;
 
@@ -536,7 +1295,7 @@ private:
                     in_focus_operation_ = false;
                 };
 
-                (*comp)->lose_focus();
+                comp->lose_focus();
             }
             else
             {
@@ -544,6 +1303,12 @@ private:
                 self_.on_focus_set();
             }
 
+            // Either of the calls above may have removed subcomponents,
+            // including this one, so its index must be found again.  The
+            // subcomponent itself is kept alive by the notification.
+            focussed_index_ =
+                subcomponents_.locate(&subcomponent, last_known_index);
+
             self_.on_cursor_position_changed();
             self_.on_cursor_state_changed();
         }
@@ -556,6 +1321,7 @@ private:
     {
         if (!in_focus_operation_)
         {
+            focussed_index_.reset();
             has_focus_ = false;
             self_.on_focus_lost();
         }
@@ -565,10 +1331,9 @@ private:
     // SUBCOMPONENT_CURSOR_STATE_CHANGE_HANDLER
     // ======================================================================
     void subcomponent_cursor_state_change_handler(
-        std::weak_ptr<component> const &weak_subcomponent)
+        component const &subcomponent)
     {
-        if (auto subcomponent = weak_subcomponent.lock();
-            subcomponent && subcomponent->has_focus())
+        if (subcomponent.has_focus())
         {
             self_.on_cursor_state_changed();
         }
@@ -578,10 +1343,9 @@ private:
     // SUBCOMPONENT_CURSOR_POSITION_CHANGE_HANDLER
     // ======================================================================
     void subcomponent_cursor_position_change_handler(
-        std::weak_ptr<component> const &weak_subcomponent)
+        component const &subcomponent)
     {
-        if (auto subcomponent = weak_subcomponent.lock();
-            subcomponent && subcomponent->has_focus())
+        if (subcomponent.has_focus())
         {
             self_.on_cursor_position_changed();
         }
@@ -590,12 +1354,12 @@ private:
     // ======================================================================
     // HANDLE_COMMON_EVENT
     // ======================================================================
-    void handle_common_event(std::any const &event)
+    template <class Event>
+    void handle_common_event(Event const &event)
     {
-        if (auto comp = find_first_focussed_component(components_);
-            comp != components_.end())
+        if (auto const comp = find_focussed_component(); comp)
         {
-            (*comp)->event(event);
+            comp->event(event);
         }
     }
 
@@ -604,13 +1368,13 @@ private:
     // ======================================================================
     void handle_mouse_event(terminalpp::mouse::event const &ev)
     {
-        if (auto const &comp =
-                find_component_at_point(components_, ev.position_);
-            comp != components_.end())
+        ensure_laid_out();
+
+        if (auto const comp = find_component_at(ev.position_); comp)
         {
-            auto const &position = (*comp)->get_position();
+            auto const &position = comp->get_position();
 
-            (*comp)->event(
+            comp->event(
                 terminalpp::mouse::event{ev.action_, ev.position_ - position});
         }
     }
@@ -618,9 +1382,13 @@ private:
     container &self_;
     terminalpp::rectangle bounds_;
     std::unique_ptr<munin::layout> layout_ = make_null_layout();
-    std::vector<std::shared_ptr<component>> components_;
-    std::vector<std::any> hints_;
-    std::vector<component_connections> component_connections_;
+    subcomponents subcomponents_;
+    mutable detail::spatial_index spatial_index_;
+    mutable bool spatial_index_dirty_ = true;
+    std::shared_ptr<munin::region> pending_redraw_;
+    mutable std::shared_ptr<bool> pending_layout_;
+    mutable std::optional<terminalpp::extent> preferred_size_;
+    mutable std::optional<std::size_t> focussed_index_;
     bool has_focus_ = false;
     bool in_focus_operation_ = false;
 };
@@ -662,6 +1430,16 @@ void container::remove_component(std::shared_ptr<component> const &comp)
     pimpl_->remove_component(comp);
 }
 
+// ==========================================================================
+// REPLACE_COMPONENTS
+// ==========================================================================
+void container::replace_components(
+    std::vector<std::shared_ptr<component>> const &components,
+    std::vector<std::any> const &layout_hints)
+{
+    pimpl_->replace_components(components, layout_hints);
+}
+
 // ==========================================================================
 // DO_SET_POSITION
 // ==========================================================================
@@ -783,6 +1561,22 @@ void container::do_event(std::any const &event)
     pimpl_->event(event);
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void container::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->key_event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void container::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->mouse_event(event);
+}
+
 // ==========================================================================
 // DO_TO_JSON
 // ==========================================================================
@@ -791,6 +1585,15 @@ nlohmann::json container::do_to_json() const
     return pimpl_->to_json();
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void container::do_census(component_census &cen) const
+{
+    component::do_census(cen);
+    pimpl_->census(cen);
+}
+
 // ==========================================================================
 // MAKE_CONTAINER
 // ==========================================================================
@@ -1,7 +1,10 @@
 #include "munin/detail/algorithm.hpp"
 
+#include "munin/render_surface.hpp"
+
 #include <terminalpp/canvas.hpp>
 
+#include <algorithm>
 
 namespace munin::detail {
 
@@ -11,6 +14,13 @@ namespace munin::detail {
 std::optional<terminalpp::rectangle> intersection(
     terminalpp::rectangle const &lhs, terminalpp::rectangle const &rhs)
 {
+    // A rectangle with no area cannot overlap anything.
+    if (lhs.size_.width_ <= 0 || lhs.size_.height_ <= 0
+        || rhs.size_.width_ <= 0 || rhs.size_.height_ <= 0)
+    {
+        return std::nullopt;
+    }
+
     // Check to see if the rectangles overlap.
 
     // Calculate the rectangle with the leftmost origin, and its counterpart.
@@ -73,4 +83,70 @@ std::optional<terminalpp::rectangle> intersection(
     return overlap;
 }
 
+// ==========================================================================
+// COPY_LINE
+// ==========================================================================
+void copy_line(
+    std::span<terminalpp::element> row,
+    terminalpp::string const &text,
+    terminalpp::coordinate_type column,
+    terminalpp::element const &fill)
+{
+    auto const row_length = static_cast<std::ptrdiff_t>(row.size());
+    auto const text_length = static_cast<std::ptrdiff_t>(text.size());
+
+    // Elements before the start of the text are filled.
+    auto const leading = std::clamp<std::ptrdiff_t>(-column, 0, row_length);
+    auto const first = std::clamp<std::ptrdiff_t>(column, 0, text_length);
+
+    // Followed by as much of the text as fits, and then filled again.
+    auto const copied = std::clamp<std::ptrdiff_t>(
+        text_length - first, 0, row_length - leading);
+
+    auto const text_begin = text.begin() + first;
+    auto const row_begin = row.begin();
+
+    std::fill(row_begin, row_begin + leading, fill);
+    std::copy(text_begin, text_begin + copied, row_begin + leading);
+    std::fill(row_begin + leading + copied, row.end(), fill);
+}
+
+// ==========================================================================
+// COPY_LINE
+// ==========================================================================
+void copy_line(
+    render_surface &surface,
+    terminalpp::point origin,
+    terminalpp::coordinate_type length,
+    terminalpp::string const &text,
+    terminalpp::coordinate_type column,
+    terminalpp::element const &fill)
+{
+    // std::clamp requires its lower bound not to exceed its upper bound,
+    // which is only so for a line of some length.
+    if (length <= 0)
+    {
+        return;
+    }
+
+    auto const text_length =
+        static_cast<terminalpp::coordinate_type>(text.size());
+    auto const leading =
+        std::clamp(-column, terminalpp::coordinate_type{0}, length);
+    auto const first =
+        std::clamp(column, terminalpp::coordinate_type{0}, text_length);
+    auto const copied = std::clamp(
+        text_length - first, terminalpp::coordinate_type{0}, length - leading);
+
+    surface.fill({origin, {leading, 1}}, fill);
+    surface.write_row(
+        {origin.x_ + leading, origin.y_},
+        std::span<terminalpp::element const>{
+            text.begin() + first, static_cast<std::size_t>(copied)});
+    surface.fill(
+        {{origin.x_ + leading + copied, origin.y_},
+         {length - leading - copied, 1}},
+        fill);
+}
+
 }  // namespace munin::detail
@@ -0,0 +1,212 @@
+#include "munin/detail/row_compare.hpp"
+
+#include <cassert>
+
+// Where the library is not compiled for AVX2 but the compiler can target it
+// function by function, an AVX2 kernel is built alongside the baseline one
+// and chosen at run time if the processor supports it.  Its functions are
+// flattened, since the comparison would otherwise not be inlined into the
+// loop that is shared with the baseline kernel.
+#if !defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define MUNIN_DISPATCH_AVX2
+#define MUNIN_TARGET_AVX2 __attribute__((target("avx2"), flatten))
+#else
+#define MUNIN_TARGET_AVX2
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) \
+    || defined(MUNIN_DISPATCH_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace munin::detail {
+
+namespace {
+
+using cell = compact_canvas::cell;
+
+// ==========================================================================
+// FIRST_DIFFERENCE
+// ==========================================================================
+std::size_t first_difference(
+    cell const *lhs, cell const *rhs, std::size_t first, std::size_t last)
+{
+    while (first != last && lhs[first] == rhs[first])
+    {
+        ++first;
+    }
+
+    return first;
+}
+
+// ==========================================================================
+// LAST_DIFFERENCE
+// ==========================================================================
+std::size_t last_difference(
+    cell const *lhs, cell const *rhs, std::size_t first, std::size_t last)
+{
+    while (last != first && lhs[last - 1] == rhs[last - 1])
+    {
+        --last;
+    }
+
+    return last;
+}
+
+// ==========================================================================
+// COMPARE_BLOCKS
+// ==========================================================================
+template <
+    std::size_t CellsPerBlock,
+    bool (*BlocksEqual)(cell const *, cell const *)>
+std::optional<row_difference> compare_blocks(
+    cell const *lhs, cell const *rhs, std::size_t size)
+{
+    // Skip forward over whole blocks of identical cells, and then find the
+    // exact column within the block that differs.
+    std::size_t first = 0;
+
+    while (first + CellsPerBlock <= size
+           && BlocksEqual(lhs + first, rhs + first))
+    {
+        first += CellsPerBlock;
+    }
+
+    first = first_difference(lhs, rhs, first, size);
+
+    if (first == size)
+    {
+        return std::nullopt;
+    }
+
+    // Likewise, skip backward from the end of the row.  This stops at the
+    // first difference at the latest.
+    std::size_t last = size;
+
+    while (last >= first + CellsPerBlock
+           && BlocksEqual(
+               lhs + last - CellsPerBlock, rhs + last - CellsPerBlock))
+    {
+        last -= CellsPerBlock;
+    }
+
+    return row_difference{first, last_difference(lhs, rhs, first, last)};
+}
+
+// ==========================================================================
+// CELLS_EQUAL
+// ==========================================================================
+bool cells_equal(cell const *lhs, cell const *rhs)
+{
+    return *lhs == *rhs;
+}
+
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(__AVX2__)
+
+// ==========================================================================
+// BLOCKS_EQUAL_SSE2
+// ==========================================================================
+bool blocks_equal_sse2(cell const *lhs, cell const *rhs)
+{
+    // Two cells are compared at a time.  SSE2 has no 64-bit comparison, but
+    // two cells are equal exactly when all of their 32-bit halves are.
+    auto const lhs_block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(lhs));
+    auto const rhs_block =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(rhs));
+
+    return _mm_movemask_epi8(_mm_cmpeq_epi32(lhs_block, rhs_block))
+        == 0xFFFF;
+}
+
+#endif
+
+#if defined(__AVX2__) || defined(MUNIN_DISPATCH_AVX2)
+
+// ==========================================================================
+// BLOCKS_EQUAL_AVX2
+// ==========================================================================
+MUNIN_TARGET_AVX2 bool blocks_equal_avx2(cell const *lhs, cell const *rhs)
+{
+    // Four cells are compared at a time.
+    auto const lhs_block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs));
+    auto const rhs_block =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs));
+
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi64(lhs_block, rhs_block))
+        == -1;
+}
+
+// ==========================================================================
+// COMPARE_ROW_AVX2
+// ==========================================================================
+MUNIN_TARGET_AVX2 std::optional<row_difference> compare_row_avx2(
+    cell const *lhs, cell const *rhs, std::size_t size)
+{
+    return compare_blocks<4, blocks_equal_avx2>(lhs, rhs, size);
+}
+
+#endif
+
+#if defined(MUNIN_DISPATCH_AVX2)
+
+// ==========================================================================
+// SUPPORTS_AVX2
+// ==========================================================================
+bool supports_avx2()
+{
+    static bool const supported = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+
+    return supported;
+}
+
+#endif
+
+}  // namespace
+
+// ==========================================================================
+// COMPARE_ROW
+// ==========================================================================
+std::optional<row_difference> compare_row(
+    std::span<compact_canvas::cell const> lhs,
+    std::span<compact_canvas::cell const> rhs)
+{
+    assert(lhs.size() == rhs.size());
+
+#if defined(__AVX2__)
+    return compare_row_avx2(lhs.data(), rhs.data(), lhs.size());
+#else
+#if defined(MUNIN_DISPATCH_AVX2)
+    if (supports_avx2())
+    {
+        return compare_row_avx2(lhs.data(), rhs.data(), lhs.size());
+    }
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+    return compare_blocks<2, blocks_equal_sse2>(
+        lhs.data(), rhs.data(), lhs.size());
+#else
+    return compare_blocks<1, cells_equal>(lhs.data(), rhs.data(), lhs.size());
+#endif
+#endif
+}
+
+// ==========================================================================
+// COMPARE_ROW_SCALAR
+// ==========================================================================
+std::optional<row_difference> compare_row_scalar(
+    std::span<compact_canvas::cell const> lhs,
+    std::span<compact_canvas::cell const> rhs)
+{
+    assert(lhs.size() == rhs.size());
+
+    return compare_blocks<1, cells_equal>(lhs.data(), rhs.data(), lhs.size());
+}
+
+}  // namespace munin::detail
@@ -0,0 +1,227 @@
+#include "munin/detail/spatial_index.hpp"
+
+#include "munin/detail/algorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace munin::detail {
+
+namespace {
+
+// ==========================================================================
+// CONTAINS
+// ==========================================================================
+bool contains(
+    terminalpp::rectangle const &rect, terminalpp::point const &location)
+{
+    return location.x_ >= rect.origin_.x_
+        && location.x_ < rect.origin_.x_ + rect.size_.width_
+        && location.y_ >= rect.origin_.y_
+        && location.y_ < rect.origin_.y_ + rect.size_.height_;
+}
+
+// ==========================================================================
+// IS_EMPTY
+// ==========================================================================
+bool is_empty(terminalpp::rectangle const &rect)
+{
+    return rect.size_.width_ <= 0 || rect.size_.height_ <= 0;
+}
+
+}  // namespace
+
+// ==========================================================================
+// REBUILD
+// ==========================================================================
+void spatial_index::rebuild(std::vector<terminalpp::rectangle> const &bounds)
+{
+    bounds_ = bounds;
+    cells_.clear();
+
+    // The grid covers the smallest area that encloses every non-empty
+    // rectangle.
+    bool first = true;
+    terminalpp::point top_left;
+    terminalpp::point bottom_right;
+
+    for (auto const &rect : bounds_)
+    {
+        if (is_empty(rect))
+        {
+            continue;
+        }
+
+        auto const right = rect.origin_.x_ + rect.size_.width_;
+        auto const bottom = rect.origin_.y_ + rect.size_.height_;
+
+        top_left = first ? rect.origin_
+                         : terminalpp::point{
+                               std::min(top_left.x_, rect.origin_.x_),
+                               std::min(top_left.y_, rect.origin_.y_)};
+        bottom_right = first ? terminalpp::point{right, bottom}
+                             : terminalpp::point{
+                                   std::max(bottom_right.x_, right),
+                                   std::max(bottom_right.y_, bottom)};
+        first = false;
+    }
+
+    if (first)
+    {
+        area_ = {};
+        grid_width_ = 0;
+        return;
+    }
+
+    area_ = {top_left, {bottom_right.x_ - top_left.x_,
+                        bottom_right.y_ - top_left.y_}};
+
+    // Aim for roughly one grid cell per rectangle, which keeps both the
+    // number of cells examined per query and the number of rectangles in
+    // each cell small for the typical case of evenly-distributed children.
+    auto const cells_per_side = std::max<terminalpp::coordinate_type>(
+        1,
+        static_cast<terminalpp::coordinate_type>(
+            std::ceil(std::sqrt(static_cast<double>(bounds_.size())))));
+
+    cell_size_ = {
+        std::max<terminalpp::coordinate_type>(
+            1, (area_.size_.width_ + cells_per_side - 1) / cells_per_side),
+        std::max<terminalpp::coordinate_type>(
+            1, (area_.size_.height_ + cells_per_side - 1) / cells_per_side)};
+
+    grid_width_ = static_cast<std::size_t>(
+        (area_.size_.width_ + cell_size_.width_ - 1) / cell_size_.width_);
+    auto const grid_height = static_cast<std::size_t>(
+        (area_.size_.height_ + cell_size_.height_ - 1) / cell_size_.height_);
+
+    cells_.resize(grid_width_ * grid_height);
+
+    for (std::size_t index = 0; index < bounds_.size(); ++index)
+    {
+        auto const &rect = bounds_[index];
+
+        if (is_empty(rect))
+        {
+            continue;
+        }
+
+        auto const first_column = cell_column(rect.origin_.x_);
+        auto const last_column =
+            cell_column(rect.origin_.x_ + rect.size_.width_ - 1);
+        auto const first_row = cell_row(rect.origin_.y_);
+        auto const last_row =
+            cell_row(rect.origin_.y_ + rect.size_.height_ - 1);
+
+        for (auto row = first_row; row <= last_row; ++row)
+        {
+            for (auto column = first_column; column <= last_column; ++column)
+            {
+                cells_[row * grid_width_ + column].push_back(index);
+            }
+        }
+    }
+}
+
+// ==========================================================================
+// QUERY
+// ==========================================================================
+std::vector<std::size_t> spatial_index::query(
+    terminalpp::rectangle const &region) const
+{
+    std::vector<std::size_t> result;
+
+    auto const clipped_region = intersection(region, area_);
+
+    if (cells_.empty() || !clipped_region)
+    {
+        return result;
+    }
+
+    auto const first_column = cell_column(clipped_region->origin_.x_);
+    auto const last_column = cell_column(
+        clipped_region->origin_.x_ + clipped_region->size_.width_ - 1);
+    auto const first_row = cell_row(clipped_region->origin_.y_);
+    auto const last_row = cell_row(
+        clipped_region->origin_.y_ + clipped_region->size_.height_ - 1);
+
+    for (auto row = first_row; row <= last_row; ++row)
+    {
+        for (auto column = first_column; column <= last_column; ++column)
+        {
+            for (auto const index : cells_[row * grid_width_ + column])
+            {
+                if (intersection(bounds_[index], *clipped_region))
+                {
+                    result.push_back(index);
+                }
+            }
+        }
+    }
+
+    // A rectangle that spans several grid cells is found once per cell.
+    std::ranges::sort(result);
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+}
+
+// ==========================================================================
+// FIND
+// ==========================================================================
+std::optional<std::size_t> spatial_index::find(
+    terminalpp::point const &location) const
+{
+    if (cells_.empty() || !contains(area_, location))
+    {
+        return std::nullopt;
+    }
+
+    // Indices are added to each cell in ascending order, so the first match
+    // is also the lowest.
+    auto const &cell =
+        cells_[cell_row(location.y_) * grid_width_
+               + cell_column(location.x_)];
+
+    auto const match = std::ranges::find_if(cell, [&](auto const index) {
+        return contains(bounds_[index], location);
+    });
+
+    return match == cell.end() ? std::nullopt
+                               : std::optional<std::size_t>{*match};
+}
+
+// ==========================================================================
+// HEAP_BYTES
+// ==========================================================================
+std::size_t spatial_index::heap_bytes() const
+{
+    auto bytes = bounds_.capacity() * sizeof(terminalpp::rectangle)
+               + cells_.capacity() * sizeof(std::vector<std::size_t>);
+
+    for (auto const &cell : cells_)
+    {
+        bytes += cell.capacity() * sizeof(std::size_t);
+    }
+
+    return bytes;
+}
+
+// ==========================================================================
+// CELL_COLUMN
+// ==========================================================================
+std::size_t spatial_index::cell_column(terminalpp::coordinate_type x) const
+{
+    return static_cast<std::size_t>((x - area_.origin_.x_) / cell_size_.width_);
+}
+
+// ==========================================================================
+// CELL_ROW
+// ==========================================================================
+std::size_t spatial_index::cell_row(terminalpp::coordinate_type y) const
+{
+    return static_cast<std::size_t>(
+        (y - area_.origin_.y_) / cell_size_.height_);
+}
+
+}  // namespace munin::detail
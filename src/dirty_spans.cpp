@@ -0,0 +1,80 @@
+#include "munin/dirty_spans.hpp"
+
+#include <algorithm>
+
+namespace munin {
+
+// ==========================================================================
+// RESET
+// ==========================================================================
+void dirty_spans::reset(terminalpp::extent size)
+{
+    width_ = size.width_;
+    rows_.assign(size.height_, span{0, 0});
+    empty_ = true;
+}
+
+// ==========================================================================
+// MARK
+// ==========================================================================
+void dirty_spans::mark(
+    terminalpp::coordinate_type row,
+    terminalpp::coordinate_type first_column,
+    terminalpp::coordinate_type last_column)
+{
+    first_column = (std::max)(first_column, terminalpp::coordinate_type{0});
+    last_column = (std::min)(last_column, width_);
+
+    if (row < 0 || row >= static_cast<terminalpp::coordinate_type>(rows_.size())
+        || first_column >= last_column)
+    {
+        return;
+    }
+
+    auto &changed = rows_[row];
+
+    if (changed.left_ >= changed.right_)
+    {
+        changed = {first_column, last_column};
+    }
+    else
+    {
+        changed.left_ = (std::min)(changed.left_, first_column);
+        changed.right_ = (std::max)(changed.right_, last_column);
+    }
+
+    empty_ = false;
+}
+
+// ==========================================================================
+// EMPTY
+// ==========================================================================
+bool dirty_spans::empty() const
+{
+    return empty_;
+}
+
+// ==========================================================================
+// RECTANGLES
+// ==========================================================================
+std::vector<terminalpp::rectangle> dirty_spans::rectangles() const
+{
+    std::vector<terminalpp::rectangle> result;
+
+    for (terminalpp::coordinate_type row = 0;
+         row < static_cast<terminalpp::coordinate_type>(rows_.size());
+         ++row)
+    {
+        if (auto const &changed = rows_[row]; changed.left_ < changed.right_)
+        {
+            result.push_back({
+                {changed.left_,                   row},
+                {changed.right_ - changed.left_, 1  }
+            });
+        }
+    }
+
+    return result;
+}
+
+}  // namespace munin
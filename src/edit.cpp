@@ -1,9 +1,10 @@
 #include "munin/edit.hpp"
 
+#include "munin/component_census.hpp"
+#include "munin/detail/algorithm.hpp"
 #include "munin/render_surface.hpp"
 
 #include <boost/range/adaptor/filtered.hpp>
-#include <terminalpp/algorithm/for_each_in_region.hpp>
 #include <terminalpp/mouse.hpp>
 #include <terminalpp/virtual_key.hpp>
 
@@ -384,22 +385,27 @@ void edit::do_set_cursor_position(terminalpp::point const &position)
 void edit::do_draw(
     render_surface &surface, terminalpp::rectangle const &region) const
 {
-    terminalpp::for_each_in_region(
-        surface,
-        region,
-        [this, size = get_size()](
-            terminalpp::element &elem,
-            terminalpp::coordinate_type column,  // NOLINT
-            terminalpp::coordinate_type row) {
-            if (column < get_length())
-            {
-                elem = pimpl_->get_content()[column];
-            }
-            else if (column < size.width_)
-            {
-                elem = ' ';
-            }
-        });
+    // Cells beyond both the width of the edit and the end of its content
+    // are left untouched, even if the requested region is larger.  A region
+    // that lies entirely beyond them draws nothing at all.
+    auto const width = (std::max)(
+        (std::min)(
+            region.size_.width_,
+            (std::max)(get_size().width_, get_length()) - region.origin_.x_),
+        terminalpp::coordinate_type{0});
+
+    for (auto row = region.origin_.y_;
+         row < region.origin_.y_ + region.size_.height_;
+         ++row)
+    {
+        detail::copy_line(
+            surface,
+            {region.origin_.x_, row},
+            width,
+            pimpl_->get_content(),
+            region.origin_.x_,
+            ' ');
+    }
 }
 
 // ==========================================================================
@@ -421,6 +427,34 @@ void edit::do_event(std::any const &ev)
     }
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void edit::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->key_event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void edit::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->mouse_event(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void edit::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this),
+        sizeof(impl)
+            + component_census::estimate_string_bytes(pimpl_->get_content()));
+}
+
 // ==========================================================================
 // MAKE_EDIT
 // ==========================================================================
@@ -2,9 +2,6 @@
 
 #include "munin/render_surface.hpp"
 
-#include <terminalpp/algorithm/for_each_in_region.hpp>
-
-
 namespace munin {
 
 // ==========================================================================
@@ -31,6 +28,14 @@ bool filled_box::do_can_receive_focus() const
     return false;
 }
 
+// ==========================================================================
+// DO_IS_OPAQUE
+// ==========================================================================
+bool filled_box::do_is_opaque() const
+{
+    return true;
+}
+
 // ==========================================================================
 // SET_PREFERRED_SIZE
 // ==========================================================================
@@ -54,15 +59,7 @@ terminalpp::extent filled_box::do_get_preferred_size() const
 void filled_box::do_draw(
     render_surface &surface, terminalpp::rectangle const &region) const
 {
-    auto const element = fill_function_(surface);
-
-    terminalpp::for_each_in_region(
-        surface,
-        region,
-        [&element](
-            terminalpp::element &elem,
-            terminalpp::coordinate_type column,  // NOLINT
-            terminalpp::coordinate_type row) { elem = element; });
+    surface.fill(region, fill_function_(surface));
 }
 
 // ==========================================================================
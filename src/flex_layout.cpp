@@ -0,0 +1,272 @@
+#include "munin/flex_layout.hpp"
+
+#include "munin/component.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace munin {
+
+namespace {
+
+// ==========================================================================
+// GET_HINT
+// ==========================================================================
+flex_layout::hint get_hint(
+    std::vector<std::any> const &hints, std::size_t index)
+{
+    auto const *flex_hint = index < hints.size()
+                              ? std::any_cast<flex_layout::hint>(&hints[index])
+                              : nullptr;
+
+    return flex_hint != nullptr ? *flex_hint : flex_layout::hint{};
+}
+
+// ==========================================================================
+// MAIN_LENGTH
+// ==========================================================================
+terminalpp::coordinate_type main_length(
+    terminalpp::extent size, flex_layout::direction dir)
+{
+    return dir == flex_layout::direction::row ? size.width_ : size.height_;
+}
+
+// ==========================================================================
+// CROSS_LENGTH
+// ==========================================================================
+terminalpp::coordinate_type cross_length(
+    terminalpp::extent size, flex_layout::direction dir)
+{
+    return dir == flex_layout::direction::row ? size.height_ : size.width_;
+}
+
+// ==========================================================================
+// APPORTION
+// ==========================================================================
+std::int64_t apportion(
+    std::int64_t amount,
+    std::int64_t cumulative_weight,
+    std::int64_t total_weight,
+    std::int64_t &apportioned)
+{
+    // Rounding the running total of the weights, rather than each weight,
+    // means that the shares always add up to exactly the amount.
+    auto const share = amount * cumulative_weight / total_weight - apportioned;
+    apportioned += share;
+    return share;
+}
+
+// A component's basis and flex factors, gathered before any space is
+// shared out.
+struct flex_item
+{
+    terminalpp::coordinate_type basis;
+    std::int64_t grow;
+    std::int64_t shrink;
+    std::int64_t shrink_weight;
+    bool emptied = false;
+};
+
+// ==========================================================================
+// EMPTY_OVERSHRUNK_ITEMS
+// ==========================================================================
+void empty_overshrunk_items(
+    std::vector<flex_item> &items,
+    std::int64_t &deficit,
+    std::int64_t &total_shrink_weight)
+{
+    // An item's share of the deficit is deficit * shrink * basis divided by
+    // the total weight, which is at least its whole basis exactly when
+    // shrink * deficit is at least the total weight.  Such an item is
+    // shrunk to nothing, and the rest of the deficit is shared among the
+    // others.  Removing it never lowers the share of any other item, so
+    // the items that are emptied are exactly those with the largest shrink
+    // factors.  Taking the items in order of decreasing shrink factor, they
+    // can all be found in a single sweep that stops at the first item that
+    // is not emptied.
+    std::vector<flex_item *> shrinking_items;
+
+    for (auto &item : items)
+    {
+        if (item.shrink_weight > 0)
+        {
+            shrinking_items.push_back(&item);
+        }
+    }
+
+    std::ranges::sort(
+        shrinking_items, std::ranges::greater{}, &flex_item::shrink);
+
+    for (auto *item : shrinking_items)
+    {
+        if (item->shrink * deficit < total_shrink_weight)
+        {
+            break;
+        }
+
+        item->emptied = true;
+        deficit -= item->basis;
+        total_shrink_weight -= item->shrink_weight;
+    }
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+flex_layout::flex_layout(direction dir) : direction_(dir)
+{
+}
+
+// ==========================================================================
+// DO_GET_PREFERRED_SIZE
+// ==========================================================================
+terminalpp::extent flex_layout::do_get_preferred_size(
+    std::vector<std::shared_ptr<component>> const &components,
+    std::vector<std::any> const &hints) const
+{
+    // The preferred size is the sum of the bases of the components in the
+    // direction of the layout, and the largest preferred length of the
+    // components across it.
+    terminalpp::coordinate_type total_basis = 0;
+    terminalpp::coordinate_type max_cross = 0;
+
+    for (std::size_t index = 0; index < components.size(); ++index)
+    {
+        auto const flex_hint = get_hint(hints, index);
+        auto const preferred_size = components[index]->get_preferred_size();
+
+        total_basis += std::max(
+            flex_hint.basis.value_or(main_length(preferred_size, direction_)),
+            0);
+        max_cross =
+            std::max(max_cross, cross_length(preferred_size, direction_));
+    }
+
+    return direction_ == direction::row
+             ? terminalpp::extent{total_basis, max_cross}
+             : terminalpp::extent{max_cross, total_basis};
+}
+
+// ==========================================================================
+// DO_LAYOUT
+// ==========================================================================
+void flex_layout::do_layout(
+    std::vector<std::shared_ptr<component>> const &components,
+    std::vector<std::any> const &hints,
+    terminalpp::extent size) const
+{
+    std::vector<flex_item> items;
+    items.reserve(components.size());
+
+    std::int64_t total_basis = 0;
+    std::int64_t total_grow = 0;
+    std::int64_t total_shrink_weight = 0;
+
+    for (std::size_t index = 0; index < components.size(); ++index)
+    {
+        auto const flex_hint = get_hint(hints, index);
+
+        // The preferred size is only needed if no basis is given.
+        auto const basis = std::max(
+            flex_hint.basis ? *flex_hint.basis
+                            : main_length(
+                                components[index]->get_preferred_size(),
+                                direction_),
+            0);
+
+        // As with CSS, components shrink in proportion to their bases, so
+        // that small components are not squashed to nothing before large
+        // ones have given up any space.
+        auto const shrink = std::int64_t{std::max(flex_hint.shrink, 0)};
+        auto const &item = items.emplace_back(flex_item{
+            .basis = basis,
+            .grow = std::max(flex_hint.grow, 0),
+            .shrink = shrink,
+            .shrink_weight = shrink * basis});
+
+        total_basis += item.basis;
+        total_grow += item.grow;
+        total_shrink_weight += item.shrink_weight;
+    }
+
+    auto const free_space = main_length(size, direction_) - total_basis;
+    auto deficit = std::max(-free_space, std::int64_t{0});
+    auto const cross = cross_length(size, direction_);
+
+    if (deficit > 0)
+    {
+        empty_overshrunk_items(items, deficit, total_shrink_weight);
+    }
+
+    std::int64_t cumulative_weight = 0;
+    std::int64_t apportioned = 0;
+    terminalpp::coordinate_type position = 0;
+
+    for (std::size_t index = 0; index < components.size(); ++index)
+    {
+        auto const &item = items[index];
+        std::int64_t length = item.basis;
+
+        if (item.emptied)
+        {
+            length = 0;
+        }
+        else if (free_space > 0 && total_grow > 0)
+        {
+            cumulative_weight += item.grow;
+            length += apportion(
+                free_space, cumulative_weight, total_grow, apportioned);
+        }
+        else if (deficit > 0 && total_shrink_weight > 0)
+        {
+            // No remaining item's share exceeds its basis, and rounding the
+            // running total never takes more than a share rounded up, so
+            // no length becomes negative.
+            cumulative_weight += item.shrink_weight;
+            length -= apportion(
+                deficit, cumulative_weight, total_shrink_weight, apportioned);
+        }
+
+        auto const main_size =
+            static_cast<terminalpp::coordinate_type>(length);
+        auto &comp = *components[index];
+
+        if (direction_ == direction::row)
+        {
+            comp.set_position({position, 0});
+            comp.set_size({main_size, cross});
+        }
+        else
+        {
+            comp.set_position({0, position});
+            comp.set_size({cross, main_size});
+        }
+
+        position += main_size;
+    }
+}
+
+// ==========================================================================
+// DO_TO_JSON
+// ==========================================================================
+nlohmann::json flex_layout::do_to_json() const
+{
+    return {
+        {"type",      "flex_layout"                                 },
+        {"direction", direction_ == direction::row ? "row" : "column"}
+    };
+}
+
+// ==========================================================================
+// MAKE_FLEX_LAYOUT
+// ==========================================================================
+std::unique_ptr<layout> make_flex_layout(flex_layout::direction dir)
+{
+    return std::make_unique<flex_layout>(dir);
+}
+
+}  // namespace munin
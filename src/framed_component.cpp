@@ -105,27 +105,7 @@ void framed_component::do_event(std::any const &ev)
     if (auto const *mouse_event = std::any_cast<terminalpp::mouse::event>(&ev);
         mouse_event)
     {
-        auto inner_mouse_event = *mouse_event;
-
-        // Mouse events *always* hit the inner component, and never the
-        // frame, so it needs adjusting inward and sending onward instead
-        // of being handled by the default event handler, who will likely
-        // send the event to the frame instead.
-
-        // Translate mouse co-ordinates to inner-component co-ordinates
-        auto inner_position = inner_component_->get_position();
-        auto inner_size = inner_component_->get_size();
-
-        inner_mouse_event.position_ -= inner_position;
-
-        // And clamp it to the bounds of the component itself.
-        inner_mouse_event.position_.x_ = std::max(
-            0, std::min(inner_size.width_ - 1, inner_mouse_event.position_.x_));
-        inner_mouse_event.position_.y_ = std::max(
-            0,
-            std::min(inner_size.height_ - 1, inner_mouse_event.position_.y_));
-
-        inner_component_->event(inner_mouse_event);
+        do_mouse_event(*mouse_event);
     }
     else
     {
@@ -133,6 +113,41 @@ void framed_component::do_event(std::any const &ev)
     }
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void framed_component::do_key_event(terminalpp::virtual_key const &event)
+{
+    forward_event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void framed_component::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    auto inner_mouse_event = event;
+
+    // Mouse events *always* hit the inner component, and never the
+    // frame, so it needs adjusting inward and sending onward instead
+    // of being handled by the default event handler, who will likely
+    // send the event to the frame instead.
+
+    // Translate mouse co-ordinates to inner-component co-ordinates
+    auto inner_position = inner_component_->get_position();
+    auto inner_size = inner_component_->get_size();
+
+    inner_mouse_event.position_ -= inner_position;
+
+    // And clamp it to the bounds of the component itself.
+    inner_mouse_event.position_.x_ = std::max(
+        0, std::min(inner_size.width_ - 1, inner_mouse_event.position_.x_));
+    inner_mouse_event.position_.y_ = std::max(
+        0, std::min(inner_size.height_ - 1, inner_mouse_event.position_.y_));
+
+    inner_component_->event(inner_mouse_event);
+}
+
 // ==========================================================================
 // DO_TO_JSON
 // ==========================================================================
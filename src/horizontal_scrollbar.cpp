@@ -1,5 +1,6 @@
 #include "munin/horizontal_scrollbar.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/detail/border_glyphs.hpp"
 #include "munin/render_surface.hpp"
 
@@ -156,21 +157,6 @@ struct horizontal_scrollbar::impl
         }
     }
 
-private:
-    // ======================================================================
-    // REDRAW_ACCORDING_TO_ASSOCIATED_FOCUS
-    // ======================================================================
-    void redraw_according_to_associated_focus()
-    {
-        if (auto comp = associated_component_.lock(); comp)
-        {
-            associated_component_has_focus_ = comp->has_focus();
-            self_.on_redraw({
-                {{}, self_.get_size()}
-            });
-        }
-    }
-
     // ======================================================================
     // HANDLE_MOUSE_EVENT
     // ======================================================================
@@ -193,6 +179,21 @@ private:
         }
     }
 
+private:
+    // ======================================================================
+    // REDRAW_ACCORDING_TO_ASSOCIATED_FOCUS
+    // ======================================================================
+    void redraw_according_to_associated_focus()
+    {
+        if (auto comp = associated_component_.lock(); comp)
+        {
+            associated_component_has_focus_ = comp->has_focus();
+            self_.on_redraw({
+                {{}, self_.get_size()}
+            });
+        }
+    }
+
     horizontal_scrollbar &self_;  // NOLINT
 
     std::weak_ptr<component> associated_component_;
@@ -268,8 +269,17 @@ bool horizontal_scrollbar::do_can_receive_focus() const
 // ==========================================================================
 void horizontal_scrollbar::do_set_size(terminalpp::extent const &size)
 {
+    auto const old_preferred_size = get_preferred_size();
+
     pimpl_->calculate_slider_position(size.width_);
     basic_component::do_set_size(size);
+
+    // A scrollbar prefers to be as wide as it actually is, so resizing it
+    // changes its preferred size.
+    if (get_preferred_size() != old_preferred_size)
+    {
+        on_preferred_size_changed();
+    }
 }
 
 // ==========================================================================
@@ -297,6 +307,25 @@ void horizontal_scrollbar::do_event(std::any const &event)
     pimpl_->handle_event(event);
 }
 
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void horizontal_scrollbar::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->handle_mouse_event(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void horizontal_scrollbar::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+    cen.add_signal(typeid(*this), on_scroll_left);
+    cen.add_signal(typeid(*this), on_scroll_right);
+}
+
 // ==========================================================================
 // MAKE_HORIZONTAL_SCROLLBAR
 // ==========================================================================
@@ -1,5 +1,7 @@
 #include "munin/image.hpp"
 
+#include "munin/component_census.hpp"
+#include "munin/detail/algorithm.hpp"
 #include "munin/detail/json_adaptors.hpp"
 #include "munin/render_surface.hpp"
 
@@ -84,26 +86,9 @@ void add_redraw_region(
 }
 
 // ==========================================================================
-// DRAW_FILL_LINE
+// DRAW_LINE
 // ==========================================================================
-void draw_fill_line(
-    render_surface &surface,
-    terminalpp::point const &origin,
-    terminalpp::coordinate_type const &width,
-    terminalpp::element const &fill)
-{
-    for (terminalpp::coordinate_type column = origin.x_;
-         column < origin.x_ + width;
-         ++column)
-    {
-        surface[column][origin.y_] = fill;
-    }
-}
-
-// ==========================================================================
-// DRAW_CONTENT_LINE
-// ==========================================================================
-void draw_content_line(
+void draw_line(
     render_surface &surface,
     terminalpp::point const &origin,
     terminalpp::coordinate_type const &content_start,  // NOLINT
@@ -111,14 +96,8 @@ void draw_content_line(
     terminalpp::string const &content,
     terminalpp::element const &fill)
 {
-    for (auto column = origin.x_; column < origin.x_ + line_width; ++column)
-    {
-        bool const column_has_content =
-            column >= content_start && column < content_start + content.size();
-
-        surface[column][origin.y_] =
-            column_has_content ? content[column - content_start] : fill;
-    }
+    detail::copy_line(
+        surface, origin, line_width, content, origin.x_ - content_start, fill);
 }
 
 }  // namespace
@@ -270,28 +249,20 @@ void image::do_draw(
          row < region.origin_.y_ + region.size_.height_;
          ++row)
     {
+        static terminalpp::string const no_content;
+
         bool const row_has_content =
             row >= content_basis.y_
             && row < content_basis.y_ + pimpl_->content.size();
 
-        if (row_has_content)
-        {
-            draw_content_line(
-                surface,
-                {region.origin_.x_, row},
-                content_basis.x_,
-                region.size_.width_,
-                pimpl_->content[row - content_basis.y_],
-                pimpl_->fill);
-        }
-        else
-        {
-            draw_fill_line(
-                surface,
-                {region.origin_.x_, row},
-                region.size_.width_,
-                pimpl_->fill);
-        }
+        draw_line(
+            surface,
+            {region.origin_.x_, row},
+            content_basis.x_,
+            region.size_.width_,
+            row_has_content ? pimpl_->content[row - content_basis.y_]
+                            : no_content,
+            pimpl_->fill);
     }
 }
 
@@ -318,6 +289,18 @@ nlohmann::json image::do_to_json() const
     return json;
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void image::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this),
+        sizeof(impl)
+            + component_census::estimate_string_bytes(pimpl_->content));
+}
+
 // ==========================================================================
 // MAKE_IMAGE
 // ==========================================================================
@@ -2,12 +2,14 @@
 
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/algorithm/max_element.hpp>
+#include <munin/component_census.hpp>
+#include <munin/detail/algorithm.hpp>
 #include <munin/render_surface.hpp>
-#include <terminalpp/algorithm/for_each_in_region.hpp>
 #include <terminalpp/mouse.hpp>
 #include <terminalpp/virtual_key.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace munin {
 
@@ -58,19 +60,34 @@ struct list::impl
     void draw(
         render_surface &surface, terminalpp::rectangle const &region) const
     {
-        terminalpp::for_each_in_region(
-            surface,
-            region,
-            [this](auto &elem, auto const column, auto const row) {
-                elem = row < items_.size() && column < items_[row].size()
-                         ? items_[row][column]
-                         : ' ';
-
-                elem.attribute_.polarity_ =
-                    selected_item_index_ && *selected_item_index_ == row
-                        ? terminalpp::graphics::polarity::negative
-                        : terminalpp::graphics::polarity::positive;
-            });
+        static terminalpp::string const no_item;
+
+        // Each row is composed separately and then written in one go, so
+        // that rows whose content is unchanged are not recorded as such.
+        std::vector<terminalpp::element> line(region.size_.width_);
+
+        for (auto row = region.origin_.y_;
+             row < region.origin_.y_ + region.size_.height_;
+             ++row)
+        {
+            detail::copy_line(
+                line,
+                row < items_.size() ? items_[row] : no_item,
+                region.origin_.x_,
+                ' ');
+
+            auto const polarity =
+                selected_item_index_ && *selected_item_index_ == row
+                    ? terminalpp::graphics::polarity::negative
+                    : terminalpp::graphics::polarity::positive;
+
+            for (auto &elem : line)
+            {
+                elem.attribute_.polarity_ = polarity;
+            }
+
+            surface.write_row({region.origin_.x_, row}, line);
+        }
     }
 
     // ======================================================================
@@ -270,6 +287,35 @@ void list::do_event(std::any const &ev)
     pimpl_->event(ev);
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void list::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->handle_keypress(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void list::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->handle_mouse_report(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void list::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this),
+        sizeof(impl)
+            + component_census::estimate_string_bytes(pimpl_->items_));
+    cen.add_signal(typeid(*this), on_item_changed);
+}
+
 // ==========================================================================
 // MAKE_LIST
 // ==========================================================================
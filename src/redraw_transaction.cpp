@@ -0,0 +1,108 @@
+#include "munin/redraw_transaction.hpp"
+
+#include <deque>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace munin {
+
+namespace {
+
+struct transaction_state
+{
+    int depth = 0;
+    std::deque<std::function<void()>> deferred;
+    std::vector<std::function<void()>> deferred_layouts;
+};
+
+thread_local transaction_state state;
+
+// ==========================================================================
+// RUN_DEFERRED
+// ==========================================================================
+void run_deferred()
+{
+    while (!state.deferred_layouts.empty() || !state.deferred.empty())
+    {
+        if (!state.deferred_layouts.empty())
+        {
+            auto fn = std::move(state.deferred_layouts.back());
+            state.deferred_layouts.pop_back();
+            fn();
+        }
+        else
+        {
+            auto fn = std::move(state.deferred.front());
+            state.deferred.pop_front();
+            fn();
+        }
+    }
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+redraw_transaction::redraw_transaction()
+  : uncaught_exceptions_(std::uncaught_exceptions())
+{
+    ++state.depth;
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+redraw_transaction::~redraw_transaction() noexcept(false)
+{
+    // The transaction is kept open while the deferred functions run so that
+    // any redraws that they cause further up the tree are also batched.
+    // Throwing from a destructor during unwinding terminates, so if an
+    // exception is passing through, the work is left for the next
+    // transaction rather than dropped, which would leave containers waiting
+    // for notifications that never come.
+    if (state.depth == 1 && std::uncaught_exceptions() <= uncaught_exceptions_)
+    {
+        try
+        {
+            run_deferred();
+        }
+        catch (...)
+        {
+            // The transaction is closed before the exception is passed on
+            // to the caller.  Whatever is still deferred is kept for the
+            // next transaction.
+            --state.depth;
+            throw;
+        }
+    }
+
+    --state.depth;
+}
+
+// ==========================================================================
+// IS_OPEN
+// ==========================================================================
+bool redraw_transaction::is_open()
+{
+    return state.depth > 0;
+}
+
+// ==========================================================================
+// DEFER
+// ==========================================================================
+void redraw_transaction::defer(std::function<void()> fn)
+{
+    state.deferred.push_back(std::move(fn));
+}
+
+// ==========================================================================
+// DEFER_LAYOUT
+// ==========================================================================
+void redraw_transaction::defer_layout(std::function<void()> fn)
+{
+    state.deferred_layouts.push_back(std::move(fn));
+}
+
+}  // namespace munin
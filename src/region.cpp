@@ -0,0 +1,373 @@
+#include "munin/region.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace munin {
+
+namespace {
+
+// ==========================================================================
+// IS_COVERED
+// ==========================================================================
+template <class Iterator>
+bool is_covered(
+    Iterator &current, Iterator last, terminalpp::coordinate_type position)
+{
+    while (current != last && current->right_ <= position)
+    {
+        ++current;
+    }
+
+    return current != last && current->left_ <= position;
+}
+
+// ==========================================================================
+// COMBINE_SPANS
+// ==========================================================================
+template <class Span, class Operation>
+std::vector<Span> combine_spans(
+    std::vector<Span> const &lhs, std::vector<Span> const &rhs, Operation &op)
+{
+    std::vector<terminalpp::coordinate_type> edges;
+    edges.reserve((lhs.size() + rhs.size()) * 2);
+
+    for (auto const &sp : lhs)
+    {
+        edges.push_back(sp.left_);
+        edges.push_back(sp.right_);
+    }
+
+    for (auto const &sp : rhs)
+    {
+        edges.push_back(sp.left_);
+        edges.push_back(sp.right_);
+    }
+
+    std::ranges::sort(edges);
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<Span> result;
+    auto lhs_current = lhs.begin();
+    auto rhs_current = rhs.begin();
+
+    for (size_t index = 1; index < edges.size(); ++index)
+    {
+        auto const left = edges[index - 1];
+        auto const right = edges[index];
+
+        if (op(is_covered(lhs_current, lhs.end(), left),
+               is_covered(rhs_current, rhs.end(), left)))
+        {
+            if (!result.empty() && result.back().right_ == left)
+            {
+                result.back().right_ = right;
+            }
+            else
+            {
+                result.push_back({left, right});
+            }
+        }
+    }
+
+    return result;
+}
+
+}  // namespace
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+region::region(terminalpp::rectangle const &rect)
+{
+    if (rect.size_.width_ > 0 && rect.size_.height_ > 0)
+    {
+        bands_.push_back(
+            {rect.origin_.y_,
+             rect.origin_.y_ + rect.size_.height_,
+             {{rect.origin_.x_, rect.origin_.x_ + rect.size_.width_}}});
+    }
+}
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+region::region(std::vector<terminalpp::rectangle> const &rects)
+{
+    for (auto const &rect : rects)
+    {
+        *this |= rect;
+    }
+}
+
+// ==========================================================================
+// EMPTY
+// ==========================================================================
+bool region::empty() const
+{
+    return bands_.empty();
+}
+
+// ==========================================================================
+// BOUNDS
+// ==========================================================================
+terminalpp::rectangle region::bounds() const
+{
+    if (bands_.empty())
+    {
+        return {};
+    }
+
+    auto left = bands_.front().spans_.front().left_;
+    auto right = bands_.front().spans_.back().right_;
+
+    for (auto const &bnd : bands_)
+    {
+        left = std::min(left, bnd.spans_.front().left_);
+        right = std::max(right, bnd.spans_.back().right_);
+    }
+
+    auto const top = bands_.front().top_;
+    auto const bottom = bands_.back().bottom_;
+
+    return {
+        {left,         top         },
+        {right - left, bottom - top}
+    };
+}
+
+// ==========================================================================
+// CONTAINS
+// ==========================================================================
+bool region::contains(terminalpp::point const &pt) const
+{
+    auto const bnd = std::ranges::find_if(
+        bands_, [&pt](auto const &candidate) {
+            return pt.y_ < candidate.bottom_;
+        });
+
+    if (bnd == bands_.end() || pt.y_ < bnd->top_)
+    {
+        return false;
+    }
+
+    return std::ranges::any_of(bnd->spans_, [&pt](auto const &sp) {
+        return pt.x_ >= sp.left_ && pt.x_ < sp.right_;
+    });
+}
+
+// ==========================================================================
+// AREA
+// ==========================================================================
+terminalpp::coordinate_type region::area() const
+{
+    return std::accumulate(
+        bands_.begin(),
+        bands_.end(),
+        terminalpp::coordinate_type{0},
+        [](auto total, auto const &bnd) {
+            for (auto const &sp : bnd.spans_)
+            {
+                total += (sp.right_ - sp.left_) * (bnd.bottom_ - bnd.top_);
+            }
+
+            return total;
+        });
+}
+
+// ==========================================================================
+// RECTANGLES
+// ==========================================================================
+std::vector<terminalpp::rectangle> region::rectangles() const
+{
+    std::vector<terminalpp::rectangle> result;
+
+    for (auto const &bnd : bands_)
+    {
+        for (auto const &sp : bnd.spans_)
+        {
+            result.push_back({
+                {sp.left_,              bnd.top_               },
+                {sp.right_ - sp.left_, bnd.bottom_ - bnd.top_}
+            });
+        }
+    }
+
+    return result;
+}
+
+// ==========================================================================
+// CLEAR
+// ==========================================================================
+void region::clear()
+{
+    bands_.clear();
+}
+
+// ==========================================================================
+// TRANSLATE
+// ==========================================================================
+void region::translate(terminalpp::point const &offset)
+{
+    for (auto &bnd : bands_)
+    {
+        bnd.top_ += offset.y_;
+        bnd.bottom_ += offset.y_;
+
+        for (auto &sp : bnd.spans_)
+        {
+            sp.left_ += offset.x_;
+            sp.right_ += offset.x_;
+        }
+    }
+}
+
+// ==========================================================================
+// OPERATOR|=
+// ==========================================================================
+region &region::operator|=(region const &rhs)
+{
+    if (bands_.empty())
+    {
+        bands_ = rhs.bands_;
+    }
+    else if (!rhs.bands_.empty())
+    {
+        combine(rhs, [](bool in_lhs, bool in_rhs) { return in_lhs || in_rhs; });
+    }
+
+    return *this;
+}
+
+// ==========================================================================
+// OPERATOR&=
+// ==========================================================================
+region &region::operator&=(region const &rhs)
+{
+    if (rhs.bands_.empty())
+    {
+        bands_.clear();
+    }
+    else if (!bands_.empty())
+    {
+        combine(rhs, [](bool in_lhs, bool in_rhs) { return in_lhs && in_rhs; });
+    }
+
+    return *this;
+}
+
+// ==========================================================================
+// OPERATOR-=
+// ==========================================================================
+region &region::operator-=(region const &rhs)
+{
+    if (!bands_.empty() && !rhs.bands_.empty())
+    {
+        combine(
+            rhs, [](bool in_lhs, bool in_rhs) { return in_lhs && !in_rhs; });
+    }
+
+    return *this;
+}
+
+// ==========================================================================
+// COMBINE
+// ==========================================================================
+template <class Operation>
+void region::combine(region const &rhs, Operation &&op)
+{
+    // Every band boundary in either region is a boundary in the result.
+    // Between any two consecutive boundaries, each region has at most one
+    // band, and so the rows in between can be combined span-by-span.
+    std::vector<terminalpp::coordinate_type> edges;
+    edges.reserve((bands_.size() + rhs.bands_.size()) * 2);
+
+    for (auto const &bnd : bands_)
+    {
+        edges.push_back(bnd.top_);
+        edges.push_back(bnd.bottom_);
+    }
+
+    for (auto const &bnd : rhs.bands_)
+    {
+        edges.push_back(bnd.top_);
+        edges.push_back(bnd.bottom_);
+    }
+
+    std::ranges::sort(edges);
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    static std::vector<span> const no_spans;
+
+    auto const &spans_at = [](auto &current, auto last, auto row)
+        -> std::vector<span> const & {
+        while (current != last && current->bottom_ <= row)
+        {
+            ++current;
+        }
+
+        return current != last && current->top_ <= row ? current->spans_
+                                                        : no_spans;
+    };
+
+    std::vector<band> result;
+    auto lhs_current = bands_.cbegin();
+    auto rhs_current = rhs.bands_.cbegin();
+
+    for (size_t index = 1; index < edges.size(); ++index)
+    {
+        auto const top = edges[index - 1];
+        auto const bottom = edges[index];
+
+        auto spans = combine_spans(
+            spans_at(lhs_current, bands_.cend(), top),
+            spans_at(rhs_current, rhs.bands_.cend(), top),
+            op);
+
+        if (spans.empty())
+        {
+            continue;
+        }
+
+        // Coalesce vertically adjacent bands that have identical spans so
+        // that the representation remains canonical.
+        if (!result.empty() && result.back().bottom_ == top
+            && result.back().spans_ == spans)
+        {
+            result.back().bottom_ = bottom;
+        }
+        else
+        {
+            result.push_back({top, bottom, std::move(spans)});
+        }
+    }
+
+    bands_ = std::move(result);
+}
+
+// ==========================================================================
+// OPERATOR|
+// ==========================================================================
+region operator|(region lhs, region const &rhs)
+{
+    return lhs |= rhs;
+}
+
+// ==========================================================================
+// OPERATOR&
+// ==========================================================================
+region operator&(region lhs, region const &rhs)
+{
+    return lhs &= rhs;
+}
+
+// ==========================================================================
+// OPERATOR-
+// ==========================================================================
+region operator-(region lhs, region const &rhs)
+{
+    return lhs -= rhs;
+}
+
+}  // namespace munin
@@ -1,7 +1,31 @@
 #include "munin/render_surface.hpp"
 
+#include "munin/detail/algorithm.hpp"
+
+#include <algorithm>
+#include <utility>
+
 namespace munin {
 
+namespace {
+
+// ==========================================================================
+// WRAP
+// ==========================================================================
+std::size_t wrap(terminalpp::coordinate_type value, std::size_t modulus)
+{
+    // Coordinates may be negative, for example when a component is
+    // scrolled, but the pattern must still repeat from its origin.
+    auto const signed_modulus =
+        static_cast<terminalpp::coordinate_type>(modulus);
+    auto const remainder = value % signed_modulus;
+
+    return static_cast<std::size_t>(
+        remainder < 0 ? remainder + signed_modulus : remainder);
+}
+
+}  // namespace
+
 default_render_surface_capabilities default_capabilities;
 
 // ==========================================================================
@@ -22,6 +46,42 @@ terminalpp::element &render_surface::column_proxy::operator[](
     return surface_.get_element(column_, row);
 }
 
+// ==========================================================================
+// CONST_COLUMN_PROXY::CONSTRUCTOR
+// ==========================================================================
+render_surface::const_column_proxy::const_column_proxy(
+    render_surface const &surface, terminalpp::coordinate_type column)
+  : surface_(surface), column_(column)
+{
+}
+
+// ==========================================================================
+// CONST_COLUMN_PROXY::OPERATOR[]
+// ==========================================================================
+terminalpp::element render_surface::const_column_proxy::operator[](
+    terminalpp::coordinate_type row) const
+{
+    return surface_.read_element(column_, row);
+}
+
+// ==========================================================================
+// SCOPED_CLIP::CONSTRUCTOR
+// ==========================================================================
+render_surface::scoped_clip::scoped_clip(
+    render_surface &surface, terminalpp::rectangle const &clip)
+  : surface_(surface)
+{
+    surface_.push_clip(clip);
+}
+
+// ==========================================================================
+// SCOPED_CLIP::DESTRUCTOR
+// ==========================================================================
+render_surface::scoped_clip::~scoped_clip()
+{
+    surface_.pop_clip();
+}
+
 // ==========================================================================
 // CONSTRUCTOR
 // ==========================================================================
@@ -39,6 +99,18 @@ render_surface::render_surface(
 {
 }
 
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+render_surface::render_surface(
+    terminalpp::canvas &cvs,
+    render_surface_capabilities const &capabilities,
+    dirty_spans &dirty)
+  : render_surface(cvs, capabilities)
+{
+    dirty_ = &dirty;
+}
+
 // ==========================================================================
 // SUPPORTS_UNICODE
 // ==========================================================================
@@ -63,6 +135,45 @@ terminalpp::extent render_surface::size() const
     return canvas_.size() - offset_;
 }
 
+// ==========================================================================
+// PUSH_CLIP
+// ==========================================================================
+void render_surface::push_clip(terminalpp::rectangle const &clip)
+{
+    auto const clip_on_canvas = terminalpp::rectangle{
+        {clip.origin_.x_ + offset_.width_, clip.origin_.y_ + offset_.height_},
+        clip.size_
+    };
+
+    clips_.push_back(
+        clips_.empty()
+            ? clip_on_canvas
+            : detail::intersection(clip_on_canvas, clips_.back())
+                  .value_or(terminalpp::rectangle{clip_on_canvas.origin_, {}}));
+}
+
+// ==========================================================================
+// POP_CLIP
+// ==========================================================================
+void render_surface::pop_clip()
+{
+    clips_.pop_back();
+}
+
+// ==========================================================================
+// CLIP_RECT
+// ==========================================================================
+terminalpp::rectangle render_surface::clip_rect() const
+{
+    auto const clip = clips_.empty() ? terminalpp::rectangle{{}, canvas_.size()}
+                                     : clips_.back();
+
+    return {
+        {clip.origin_.x_ - offset_.width_, clip.origin_.y_ - offset_.height_},
+        clip.size_
+    };
+}
+
 // ==========================================================================
 // OPERATOR[]
 // ==========================================================================
@@ -72,13 +183,292 @@ render_surface::column_proxy render_surface::operator[](
     return {*this, column};
 }
 
+// ==========================================================================
+// OPERATOR[]
+// ==========================================================================
+render_surface::const_column_proxy render_surface::operator[](
+    terminalpp::coordinate_type column) const
+{
+    return {*this, column};
+}
+
+// ==========================================================================
+// ROW_SPAN
+// ==========================================================================
+std::span<terminalpp::element> render_surface::row_span(
+    terminalpp::point origin, size_type length)
+{
+    auto const elements = unrecorded_row_span(origin, length);
+    cells_written_ += elements.size();
+    record_changes(elements, 0, elements.size());
+    return elements;
+}
+
+// ==========================================================================
+// WRITE_ROW
+// ==========================================================================
+void render_surface::write_row(
+    terminalpp::point origin, std::span<terminalpp::element const> elements)
+{
+    // Discard any elements that would lie to the left of the clip.
+    if (auto const excess =
+            canvas_clip().origin_.x_ - (origin.x_ + offset_.width_);
+        excess > 0)
+    {
+        auto const skipped =
+            (std::min)(elements.size(), static_cast<std::size_t>(excess));
+        elements = elements.subspan(skipped);
+        origin.x_ += static_cast<terminalpp::coordinate_type>(skipped);
+    }
+
+    auto const destination =
+        unrecorded_row_span(origin, static_cast<size_type>(elements.size()));
+    auto first_changed = destination.size();
+    cells_written_ += destination.size();
+    auto last_changed = std::size_t{0};
+
+    for (std::size_t index = 0; index < destination.size(); ++index)
+    {
+        if (destination[index] != elements[index])
+        {
+            destination[index] = elements[index];
+            first_changed = (std::min)(first_changed, index);
+            last_changed = index + 1;
+        }
+    }
+
+    record_changes(destination, first_changed, last_changed);
+}
+
+// ==========================================================================
+// FILL
+// ==========================================================================
+void render_surface::fill(
+    terminalpp::rectangle const &region, terminalpp::element const &elem)
+{
+    auto const clipped = clip_left(region);
+
+    for (auto row = clipped.origin_.y_;
+         row < clipped.origin_.y_ + clipped.size_.height_;
+         ++row)
+    {
+        auto const destination = unrecorded_row_span(
+            {clipped.origin_.x_, row}, clipped.size_.width_);
+        auto first_changed = destination.size();
+        cells_written_ += destination.size();
+        auto last_changed = std::size_t{0};
+
+        for (std::size_t index = 0; index < destination.size(); ++index)
+        {
+            if (destination[index] != elem)
+            {
+                destination[index] = elem;
+                first_changed = (std::min)(first_changed, index);
+                last_changed = index + 1;
+            }
+        }
+
+        record_changes(destination, first_changed, last_changed);
+    }
+}
+
+// ==========================================================================
+// TILE
+// ==========================================================================
+void render_surface::tile(
+    terminalpp::rectangle const &region,
+    std::vector<terminalpp::string> const &pattern)
+{
+    auto const clipped = clip_left(region);
+
+    if (pattern.empty() || clipped.size_.width_ <= 0)
+    {
+        return;
+    }
+
+    auto const first_column = clipped.origin_.x_;
+    auto const first_row = clipped.origin_.y_;
+    auto const last_row = first_row + clipped.size_.height_;
+    auto const pattern_height =
+        static_cast<terminalpp::coordinate_type>(pattern.size());
+
+    // Each line of the pattern is laid out across the width of the region
+    // only once, and is then copied into every row that uses it.
+    std::vector<terminalpp::element> tiled_line(
+        static_cast<std::size_t>(clipped.size_.width_));
+
+    for (auto row = first_row;
+         row < (std::min)(last_row, first_row + pattern_height);
+         ++row)
+    {
+        auto const &line = pattern[wrap(row, pattern.size())];
+
+        if (line.empty())
+        {
+            continue;
+        }
+
+        auto line_column = wrap(first_column, line.size());
+
+        for (auto &elem : tiled_line)
+        {
+            elem = line[line_column];
+
+            if (++line_column == line.size())
+            {
+                line_column = 0;
+            }
+        }
+
+        for (auto tiled_row = row; tiled_row < last_row;
+             tiled_row += pattern_height)
+        {
+            write_row({first_column, tiled_row}, tiled_line);
+        }
+    }
+}
+
+// ==========================================================================
+// CELLS_WRITTEN
+// ==========================================================================
+std::uint64_t render_surface::cells_written() const
+{
+    return cells_written_;
+}
+
+// ==========================================================================
+// UNRECORDED_ROW_SPAN
+// ==========================================================================
+std::span<terminalpp::element> render_surface::unrecorded_row_span(
+    terminalpp::point origin, size_type length)
+{
+    auto const clip = canvas_clip();
+    auto const column = origin.x_ + offset_.width_;
+    auto const row = origin.y_ + offset_.height_;
+    auto const clip_right = clip.origin_.x_ + clip.size_.width_;
+
+    if (length <= 0 || column < clip.origin_.x_ || column >= clip_right
+        || row < clip.origin_.y_ || row >= clip.origin_.y_ + clip.size_.height_)
+    {
+        return {};
+    }
+
+    // The elements of the canvas are stored row by row, so that a run of
+    // elements within a single row is contiguous in memory.
+    return {
+        &canvas_[column][row],
+        static_cast<std::size_t>((std::min)(length, clip_right - column))};
+}
+
+// ==========================================================================
+// RECORD_CHANGES
+// ==========================================================================
+void render_surface::record_changes(
+    std::span<terminalpp::element const> elements,
+    std::size_t first,
+    std::size_t last)
+{
+    if (dirty_ == nullptr || first >= last)
+    {
+        return;
+    }
+
+    // Since the elements are a run within a row of the canvas, their
+    // position can be recovered from their offset into the canvas.
+    auto const index = elements.data() - &*std::as_const(canvas_).begin();
+    auto const width = canvas_.size().width_;
+    auto const row = static_cast<terminalpp::coordinate_type>(index / width);
+    auto const column = static_cast<terminalpp::coordinate_type>(index % width);
+
+    dirty_->mark(
+        row,
+        column + static_cast<terminalpp::coordinate_type>(first),
+        column + static_cast<terminalpp::coordinate_type>(last));
+}
+
+// ==========================================================================
+// CANVAS_CLIP
+// ==========================================================================
+terminalpp::rectangle render_surface::canvas_clip() const
+{
+    auto const canvas_bounds = terminalpp::rectangle{{}, canvas_.size()};
+
+    return clips_.empty()
+             ? canvas_bounds
+             : detail::intersection(clips_.back(), canvas_bounds)
+                   .value_or(terminalpp::rectangle{});
+}
+
+// ==========================================================================
+// CLIP_LEFT
+// ==========================================================================
+terminalpp::rectangle render_surface::clip_left(
+    terminalpp::rectangle region) const
+{
+    if (auto const excess =
+            canvas_clip().origin_.x_ - (region.origin_.x_ + offset_.width_);
+        excess > 0)
+    {
+        region.origin_.x_ += excess;
+        region.size_.width_ -= excess;
+    }
+
+    return region;
+}
+
 // ==========================================================================
 // GET_ELEMENT
 // ==========================================================================
 terminalpp::element &render_surface::get_element(
     terminalpp::coordinate_type column, terminalpp::coordinate_type row)
 {
-    return canvas_[column + offset_.width_][row + offset_.height_];
+    auto const position = terminalpp::point{
+        column + offset_.width_, row + offset_.height_};
+
+    if (!clips_.empty())
+    {
+        auto const &clip = clips_.back();
+
+        if (position.x_ < clip.origin_.x_
+            || position.x_ >= clip.origin_.x_ + clip.size_.width_
+            || position.y_ < clip.origin_.y_
+            || position.y_ >= clip.origin_.y_ + clip.size_.height_)
+        {
+            // Changes to the element are discarded, but it must still read
+            // as the content of the canvas, not as whatever was last
+            // written to a clipped element.
+            clipped_element_ = read_element(column, row);
+            return clipped_element_;
+        }
+    }
+
+    ++cells_written_;
+
+    if (dirty_ != nullptr)
+    {
+        dirty_->mark(position.y_, position.x_, position.x_ + 1);
+    }
+
+    return canvas_[position.x_][position.y_];
+}
+
+// ==========================================================================
+// READ_ELEMENT
+// ==========================================================================
+terminalpp::element render_surface::read_element(
+    terminalpp::coordinate_type column, terminalpp::coordinate_type row) const
+{
+    auto const position = terminalpp::point{
+        column + offset_.width_, row + offset_.height_};
+    auto const canvas_size = canvas_.size();
+
+    if (position.x_ < 0 || position.x_ >= canvas_size.width_
+        || position.y_ < 0 || position.y_ >= canvas_size.height_)
+    {
+        return {};
+    }
+
+    return canvas_[position.x_][position.y_];
 }
 
 }  // namespace munin
@@ -0,0 +1,92 @@
+#include "munin/repaint_scheduler.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std::literals;
+
+namespace munin {
+
+// ==========================================================================
+// REPAINT_SCHEDULER::IMPLEMENTATION STRUCTURE
+// ==========================================================================
+struct repaint_scheduler::impl
+{
+    std::chrono::steady_clock::duration frame_interval_ = 16ms;
+    std::chrono::steady_clock::time_point last_frame_time_;
+    bool repaint_pending_ = false;
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+repaint_scheduler::repaint_scheduler() : pimpl_(std::make_unique<impl>())
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+repaint_scheduler::~repaint_scheduler() = default;
+
+// ==========================================================================
+// SET_FRAME_INTERVAL
+// ==========================================================================
+void repaint_scheduler::set_frame_interval(
+    std::chrono::steady_clock::duration const interval)
+{
+    pimpl_->frame_interval_ = interval;
+}
+
+// ==========================================================================
+// FRAME_INTERVAL
+// ==========================================================================
+std::chrono::steady_clock::duration repaint_scheduler::frame_interval() const
+{
+    return pimpl_->frame_interval_;
+}
+
+// ==========================================================================
+// REQUEST_REPAINT
+// ==========================================================================
+void repaint_scheduler::request_repaint()
+{
+    // If a repaint is already pending, then this request will be satisfied
+    // by it.
+    if (std::exchange(pimpl_->repaint_pending_, true))
+    {
+        return;
+    }
+
+    // Otherwise, the repaint happens at the start of the next frame.  The
+    // timer is always used, even if that frame is due now, so that a burst
+    // of requests from a single event is coalesced.
+    reset_timer(std::max(
+        now(), pimpl_->last_frame_time_ + pimpl_->frame_interval_));
+}
+
+// ==========================================================================
+// START_FRAME
+// ==========================================================================
+void repaint_scheduler::start_frame()
+{
+    if (!std::exchange(pimpl_->repaint_pending_, false))
+    {
+        return;
+    }
+
+    // The next frame is measured from when this one actually started.  If
+    // we are running late, then the frames in between are simply skipped.
+    pimpl_->last_frame_time_ = now();
+    on_repaint();
+}
+
+// ==========================================================================
+// NOW
+// ==========================================================================
+std::chrono::steady_clock::time_point repaint_scheduler::now() const
+{
+    return do_now();
+}
+
+}  // namespace munin
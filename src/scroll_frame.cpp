@@ -1,6 +1,7 @@
 #include "munin/scroll_frame.hpp"
 
 #include "munin/compass_layout.hpp"
+#include "munin/component_census.hpp"
 #include "munin/detail/adaptive_fill.hpp"
 #include "munin/horizontal_scrollbar.hpp"
 #include "munin/vertical_scrollbar.hpp"
@@ -214,6 +215,15 @@ void scroll_frame::do_inner_focus_changed()
     pimpl_->redraw_frame();
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void scroll_frame::do_census(component_census &cen) const
+{
+    frame::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+}
+
 // ==========================================================================
 // MAKE_SOLID_FRAME
 // ==========================================================================
@@ -1,5 +1,6 @@
 #include "munin/scroll_pane.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/scroll_frame.hpp"
 #include "munin/viewport.hpp"
 
@@ -91,6 +92,15 @@ void scroll_pane::set_lowlight_attribute(terminalpp::attribute const &attr)
     pimpl_->frame_->set_lowlight_attribute(attr);
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void scroll_pane::do_census(component_census &cen) const
+{
+    framed_component::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+}
+
 // ==========================================================================
 // MAKE_SCROLL_PANE
 // ==========================================================================
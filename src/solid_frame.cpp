@@ -1,6 +1,7 @@
 #include "munin/solid_frame.hpp"
 
 #include "munin/compass_layout.hpp"
+#include "munin/component_census.hpp"
 #include "munin/detail/adaptive_fill.hpp"
 #include "munin/view.hpp"
 
@@ -161,6 +162,15 @@ void solid_frame::do_inner_focus_changed()
     pimpl_->redraw_frame();
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void solid_frame::do_census(component_census &cen) const
+{
+    frame::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+}
+
 // ==========================================================================
 // MAKE_SOLID_FRAME
 // ==========================================================================
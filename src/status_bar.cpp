@@ -1,6 +1,7 @@
 #include "munin/status_bar.hpp"
 
 #include <munin/animator.hpp>
+#include <munin/component_census.hpp>
 #include <munin/render_surface.hpp>
 #include <terminalpp/algorithm/for_each_in_region.hpp>
 #include <terminalpp/element.hpp>
@@ -125,6 +126,18 @@ void status_bar::do_draw(
     }
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void status_bar::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this),
+        sizeof(impl)
+            + component_census::estimate_string_bytes(pimpl_->message_));
+}
+
 // ==========================================================================
 // MAKE_STATUS_BAR
 // ==========================================================================
@@ -1,9 +1,10 @@
 #include "munin/text_area.hpp"
 
+#include "munin/component_census.hpp"
+#include "munin/detail/algorithm.hpp"
 #include "munin/render_surface.hpp"
 
 #include <boost/range/algorithm_ext/insert.hpp>
-#include <terminalpp/algorithm/for_each_in_region.hpp>
 #include <terminalpp/mouse.hpp>
 #include <terminalpp/virtual_key.hpp>
 
@@ -130,18 +131,20 @@ struct text_area::impl
     // ======================================================================
     void draw(render_surface &surface, terminalpp::rectangle const &region)
     {
-        terminalpp::for_each_in_region(
-            surface,
-            region,
-            [this](
-                terminalpp::element &elem,
-                terminalpp::coordinate_type column,
-                terminalpp::coordinate_type row) {
-                elem = (laid_out_text_.size() > row
-                        && laid_out_text_[row].size() > column)
-                         ? laid_out_text_[row][column]
-                         : ' ';
-            });
+        static terminalpp::string const no_text;
+
+        for (auto row = region.origin_.y_;
+             row < region.origin_.y_ + region.size_.height_;
+             ++row)
+        {
+            detail::copy_line(
+                surface,
+                {region.origin_.x_, row},
+                region.size_.width_,
+                row < laid_out_text_.size() ? laid_out_text_[row] : no_text,
+                region.origin_.x_,
+                ' ');
+        }
     }
 
     // ======================================================================
@@ -166,6 +169,22 @@ struct text_area::impl
         }
     }
 
+    // ======================================================================
+    // EVENT
+    // ======================================================================
+    void event(terminalpp::virtual_key const &ev)
+    {
+        handle_keypress_event(ev);
+    }
+
+    // ======================================================================
+    // EVENT
+    // ======================================================================
+    void event(terminalpp::mouse::event const &ev)
+    {
+        handle_mouse_event(ev);
+    }
+
     // ======================================================================
     // RESIZE
     // ======================================================================
@@ -176,6 +195,15 @@ struct text_area::impl
         update_cursor_position();
     }
 
+    // ======================================================================
+    // HEAP_BYTES
+    // ======================================================================
+    [[nodiscard]] std::size_t heap_bytes() const
+    {
+        return sizeof(*this) + component_census::estimate_string_bytes(text_)
+             + component_census::estimate_string_bytes(laid_out_text_);
+    }
+
 private:
     // ======================================================================
     // LAYOUT_TEXT
@@ -212,6 +240,23 @@ private:
         }
     }
 
+    // ======================================================================
+    // RELAYOUT_EDITED_TEXT
+    // ======================================================================
+    void relayout_edited_text()
+    {
+        // Editing the text can change the number of lines over which it is
+        // laid out, and therefore the preferred height of the text area.
+        auto const old_preferred_size = get_preferred_size();
+
+        layout_text();
+
+        if (get_preferred_size() != old_preferred_size)
+        {
+            self_.on_preferred_size_changed();
+        }
+    }
+
     // ======================================================================
     // CLAMP_CURSOR_POSITION
     // ======================================================================
@@ -397,7 +442,7 @@ private:
                 text_.begin() + caret_position_);
             set_caret_position(caret_position_ - 1);
 
-            layout_text();
+            relayout_edited_text();
             self_.on_redraw({
                 {{0, cursor_position_.y_},
                  {size.width_, size.height_ - cursor_position_.y_}}
@@ -476,7 +521,7 @@ private:
         text_.insert(text_.begin() + caret_position_, by);
         set_caret_position(caret_position_ + 1);
 
-        layout_text();
+        relayout_edited_text();
         self_.on_redraw({
             {{0, cursor_position_.y_},
              {width_,
@@ -635,6 +680,31 @@ void text_area::do_event(std::any const &ev)
     pimpl_->event(ev);
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void text_area::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void text_area::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->event(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void text_area::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), pimpl_->heap_bytes());
+}
+
 // ==========================================================================
 // MAKE_TEXT_AREA
 // ==========================================================================
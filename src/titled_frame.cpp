@@ -1,6 +1,7 @@
 #include "munin/titled_frame.hpp"
 
 #include "munin/compass_layout.hpp"
+#include "munin/component_census.hpp"
 #include "munin/detail/adaptive_fill.hpp"
 #include "munin/image.hpp"
 #include "munin/view.hpp"
@@ -188,6 +189,18 @@ void titled_frame::do_inner_focus_changed()
     pimpl_->redraw_frame();
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void titled_frame::do_census(component_census &cen) const
+{
+    frame::do_census(cen);
+    cen.add_heap_bytes(
+        typeid(*this),
+        sizeof(impl)
+            + component_census::estimate_string_bytes(pimpl_->title_text_));
+}
+
 // ==========================================================================
 // MAKE_SOLID_FRAME
 // ==========================================================================
@@ -1,5 +1,6 @@
 #include "munin/toggle_button.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/filled_box.hpp"
 #include "munin/framed_component.hpp"
 #include "munin/grid_layout.hpp"
@@ -64,20 +65,35 @@ void toggle_button::do_event(std::any const &ev)
     if (auto const *mouse_event = std::any_cast<terminalpp::mouse::event>(&ev);
         mouse_event != nullptr)
     {
-        if (mouse_event->action_
-            == terminalpp::mouse::event_type::left_button_down)
-        {
-            set_toggle_state(!pimpl_->toggle_state);
-        }
+        do_mouse_event(*mouse_event);
     }
     else if (auto const *vk = std::any_cast<terminalpp::virtual_key>(&ev);
              vk != nullptr)
     {
-        if (vk->key == terminalpp::vk::enter
-            || vk->key == terminalpp::vk::space)
-        {
-            set_toggle_state(!pimpl_->toggle_state);
-        }
+        do_key_event(*vk);
+    }
+}
+
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void toggle_button::do_key_event(terminalpp::virtual_key const &event)
+{
+    if (event.key == terminalpp::vk::enter
+        || event.key == terminalpp::vk::space)
+    {
+        set_toggle_state(!pimpl_->toggle_state);
+    }
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void toggle_button::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    if (event.action_ == terminalpp::mouse::event_type::left_button_down)
+    {
+        set_toggle_state(!pimpl_->toggle_state);
     }
 }
 
@@ -96,6 +112,16 @@ nlohmann::json toggle_button::do_to_json() const
     return json;
 }
 
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void toggle_button::do_census(component_census &cen) const
+{
+    composite_component::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+    cen.add_signal(typeid(*this), on_state_changed);
+}
+
 // ==========================================================================
 // MAKE_BUTTON
 // ==========================================================================
@@ -0,0 +1,198 @@
+#include "munin/trace.hpp"
+
+#include "munin/component.hpp"
+
+#include <boost/core/demangle.hpp>
+
+#include <cassert>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+
+namespace munin {
+
+// ==========================================================================
+// TRACE_BUFFER::IMPLEMENTATION STRUCTURE
+// ==========================================================================
+struct trace_buffer::impl
+{
+    std::mutex mutex_;
+    std::vector<trace_event> events_;
+    std::size_t capacity_;
+    std::size_t next_ = 0;
+    std::unordered_map<std::type_index, std::string> type_names_;
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+trace_buffer::trace_buffer(std::size_t const capacity)
+  : pimpl_(std::make_unique<impl>())
+{
+    assert(capacity > 0);
+    pimpl_->capacity_ = capacity;
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+trace_buffer::~trace_buffer() = default;
+
+// ==========================================================================
+// RECORD
+// ==========================================================================
+void trace_buffer::record(trace_event ev)
+{
+    std::scoped_lock const lock{pimpl_->mutex_};
+
+    if (pimpl_->events_.size() < pimpl_->capacity_)
+    {
+        pimpl_->events_.push_back(std::move(ev));
+    }
+    else
+    {
+        pimpl_->events_[pimpl_->next_] = std::move(ev);
+    }
+
+    pimpl_->next_ = (pimpl_->next_ + 1) % pimpl_->capacity_;
+}
+
+// ==========================================================================
+// TYPE_OF
+// ==========================================================================
+std::string const &trace_buffer::type_of(component const &comp)
+{
+    auto const key = std::type_index(typeid(comp));
+    std::scoped_lock const lock{pimpl_->mutex_};
+
+    // Elements of an unordered_map are never moved, and names are never
+    // removed from the cache, so the reference outlives the lock.
+    auto const [it, inserted] = pimpl_->type_names_.try_emplace(key);
+
+    if (inserted)
+    {
+        it->second = boost::core::demangle(key.name());
+    }
+
+    return it->second;
+}
+
+// ==========================================================================
+// EVENTS
+// ==========================================================================
+std::vector<trace_event> trace_buffer::events() const
+{
+    std::scoped_lock const lock{pimpl_->mutex_};
+    auto const &events = pimpl_->events_;
+
+    if (events.size() < pimpl_->capacity_)
+    {
+        return events;
+    }
+
+    // The buffer has wrapped, so the oldest event is the one that will be
+    // overwritten next.
+    std::vector<trace_event> result;
+    result.reserve(events.size());
+    result.insert(
+        result.end(),
+        events.begin() + static_cast<std::ptrdiff_t>(pimpl_->next_),
+        events.end());
+    result.insert(
+        result.end(),
+        events.begin(),
+        events.begin() + static_cast<std::ptrdiff_t>(pimpl_->next_));
+    return result;
+}
+
+// ==========================================================================
+// CLEAR
+// ==========================================================================
+void trace_buffer::clear()
+{
+    std::scoped_lock const lock{pimpl_->mutex_};
+    pimpl_->events_.clear();
+    pimpl_->next_ = 0;
+}
+
+// ==========================================================================
+// TO_JSON
+// ==========================================================================
+nlohmann::json trace_buffer::to_json() const
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    auto trace_events = nlohmann::json::array();
+    std::map<std::thread::id, int> thread_numbers;
+
+    for (auto const &ev : events())
+    {
+        auto const tid =
+            thread_numbers
+                .try_emplace(
+                    ev.thread, static_cast<int>(thread_numbers.size()) + 1)
+                .first->second;
+
+        trace_events.push_back({
+            {"name", ev.type                                                },
+            {"cat",  ev.category                                            },
+            {"ph",   "X"                                                    },
+            {"ts",
+             duration_cast<microseconds>(ev.start.time_since_epoch()).count()},
+            {"dur",  duration_cast<microseconds>(ev.duration).count()       },
+            {"pid",  1                                                      },
+            {"tid",  tid                                                    },
+            {"args",
+             {{"width", ev.region_size.width_},
+              {"height", ev.region_size.height_},
+              {"cells", ev.cells}}                                          }
+        });
+    }
+
+    return {
+        {"traceEvents", std::move(trace_events)}
+    };
+}
+
+// ==========================================================================
+// GLOBAL_TRACE_BUFFER
+// ==========================================================================
+trace_buffer &global_trace_buffer()
+{
+    static trace_buffer buffer;
+    return buffer;
+}
+
+// ==========================================================================
+// TRACE_SCOPE::CONSTRUCTOR
+// ==========================================================================
+trace_scope::trace_scope(
+    char const *category,
+    component const &comp,
+    terminalpp::rectangle const &region)
+{
+    // The type lookup is done before the clock starts so that the first
+    // lookup for a given type, which demangles its name, is not counted as
+    // part of the operation.
+    event_.category = category;
+    event_.type = global_trace_buffer().type_of(comp);
+    event_.region_size = region.size_;
+    event_.cells = static_cast<std::uint64_t>(region.size_.width_)
+                 * static_cast<std::uint64_t>(region.size_.height_);
+    event_.thread = std::this_thread::get_id();
+    event_.start = std::chrono::steady_clock::now();
+}
+
+// ==========================================================================
+// TRACE_SCOPE::DESTRUCTOR
+// ==========================================================================
+trace_scope::~trace_scope()
+{
+    event_.duration = std::chrono::steady_clock::now() - event_.start;
+    global_trace_buffer().record(std::move(event_));
+}
+
+}  // namespace munin
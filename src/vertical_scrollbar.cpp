@@ -1,5 +1,6 @@
 #include "munin/vertical_scrollbar.hpp"
 
+#include "munin/component_census.hpp"
 #include "munin/detail/border_glyphs.hpp"
 #include "munin/render_surface.hpp"
 
@@ -121,6 +122,28 @@ struct vertical_scrollbar::impl
         }
     }
 
+    // ======================================================================
+    // HANDLE_MOUSE_EVENT
+    // ======================================================================
+    void handle_mouse_event(terminalpp::mouse::event const &mouse_event)
+    {
+        if (mouse_event.action_
+            == terminalpp::mouse::event_type::left_button_down)
+        {
+            if (slider_position_.has_value())
+            {
+                if (mouse_event.position_.y_ < *slider_position_)
+                {
+                    self_.on_scroll_up();
+                }
+                else if (mouse_event.position_.y_ > *slider_position_)
+                {
+                    self_.on_scroll_down();
+                }
+            }
+        }
+    }
+
     // ======================================================================
     // CALCULATE_SLIDER_POSITION
     // ======================================================================
@@ -172,28 +195,6 @@ private:
         }
     }
 
-    // ======================================================================
-    // HANDLE_MOUSE_EVENT
-    // ======================================================================
-    void handle_mouse_event(terminalpp::mouse::event const &mouse_event)
-    {
-        if (mouse_event.action_
-            == terminalpp::mouse::event_type::left_button_down)
-        {
-            if (slider_position_.has_value())
-            {
-                if (mouse_event.position_.y_ < *slider_position_)
-                {
-                    self_.on_scroll_up();
-                }
-                else if (mouse_event.position_.y_ > *slider_position_)
-                {
-                    self_.on_scroll_down();
-                }
-            }
-        }
-    }
-
     vertical_scrollbar &self_;
 
     std::weak_ptr<component> associated_component_;
@@ -268,8 +269,17 @@ bool vertical_scrollbar::do_can_receive_focus() const
 // ==========================================================================
 void vertical_scrollbar::do_set_size(terminalpp::extent const &size)
 {
+    auto const old_preferred_size = get_preferred_size();
+
     pimpl_->calculate_slider_position(size.height_);
     basic_component::do_set_size(size);
+
+    // A scrollbar prefers to be as tall as it actually is, so resizing it
+    // changes its preferred size.
+    if (get_preferred_size() != old_preferred_size)
+    {
+        on_preferred_size_changed();
+    }
 }
 
 // ==========================================================================
@@ -297,6 +307,25 @@ void vertical_scrollbar::do_event(std::any const &event)
     pimpl_->handle_event(event);
 }
 
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void vertical_scrollbar::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->handle_mouse_event(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void vertical_scrollbar::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_heap_bytes(typeid(*this), sizeof(impl));
+    cen.add_signal(typeid(*this), on_scroll_up);
+    cen.add_signal(typeid(*this), on_scroll_down);
+}
+
 // ==========================================================================
 // MAKE_VERTICAL_SCROLLBAR
 // ==========================================================================
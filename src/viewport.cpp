@@ -1,14 +1,16 @@
 #include "munin/viewport.hpp"
 
+#include "munin/component_census.hpp"
+#include "munin/detail/algorithm.hpp"
+#include "munin/region.hpp"
 #include "munin/render_surface.hpp"
 
-#include <boost/range/adaptor/filtered.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 #include <boost/scope_exit.hpp>
 #include <terminalpp/mouse.hpp>
 #include <terminalpp/virtual_key.hpp>
 
 #include <algorithm>
+#include <cassert>
 #include <memory>
 #include <utility>
 
@@ -118,8 +120,23 @@ struct viewport::impl
     // ======================================================================
     // DRAW
     // ======================================================================
-    void draw(render_surface &surface, terminalpp::rectangle const &region)
+    void draw(
+        render_surface &surface, terminalpp::rectangle const &requested)
     {
+        // Only the part of the tracked component that is both within the
+        // viewport and within the surface's clip can be seen.
+        render_surface::scoped_clip const clip{
+            surface, {{}, self_.get_size()}};
+
+        auto const visible =
+            detail::intersection(requested, surface.clip_rect());
+
+        if (!visible)
+        {
+            return;
+        }
+
+        auto const &region = *visible;
         auto const offset_region = terminalpp::rectangle{
             region.origin_ + anchor_bounds_.origin_, region.size_};
 
@@ -148,51 +165,63 @@ struct viewport::impl
     // ======================================================================
     // EVENT
     // ======================================================================
-    auto event(std::any const &ev)
+    void event(std::any const &ev)
     {
-        if (auto const *mouse_event =
-                std::any_cast<terminalpp::mouse::event>(&ev);
-            mouse_event)
+        if (auto const *mouse = std::any_cast<terminalpp::mouse::event>(&ev);
+            mouse)
         {
-            auto const translated_event = terminalpp::mouse::event{
-                mouse_event->action_,
-                mouse_event->position_ + anchor_bounds_.origin_};
-
-            return tracked_component_->event(translated_event);
+            mouse_event(*mouse);
         }
-        else if (auto const *keypress_event =
+        else if (auto const *keypress =
                      std::any_cast<terminalpp::virtual_key>(&ev);
-                 keypress_event)
+                 keypress)
         {
-            if (keypress_event->key == terminalpp::vk::pgup)
-            {
-                auto const viewport_height = self_.get_size().height_;
-                auto const cursor_position =
-                    tracked_component_->get_cursor_position();
-
-                tracked_component_->set_cursor_position(
-                    {cursor_position.x_, cursor_position.y_ - viewport_height});
-            }
-            else if (keypress_event->key == terminalpp::vk::pgdn)
-            {
-                auto const viewport_height = self_.get_size().height_;
-                auto const cursor_position =
-                    tracked_component_->get_cursor_position();
-
-                tracked_component_->set_cursor_position(
-                    {cursor_position.x_, cursor_position.y_ + viewport_height});
-            }
-            else
-            {
-                tracked_component_->event(ev);
-            }
+            key_event(*keypress);
         }
         else
         {
-            return tracked_component_->event(ev);
+            tracked_component_->event(ev);
         }
     }
 
+    // ======================================================================
+    // KEY_EVENT
+    // ======================================================================
+    void key_event(terminalpp::virtual_key const &keypress_event)
+    {
+        if (keypress_event.key == terminalpp::vk::pgup)
+        {
+            auto const viewport_height = self_.get_size().height_;
+            auto const cursor_position =
+                tracked_component_->get_cursor_position();
+
+            tracked_component_->set_cursor_position(
+                {cursor_position.x_, cursor_position.y_ - viewport_height});
+        }
+        else if (keypress_event.key == terminalpp::vk::pgdn)
+        {
+            auto const viewport_height = self_.get_size().height_;
+            auto const cursor_position =
+                tracked_component_->get_cursor_position();
+
+            tracked_component_->set_cursor_position(
+                {cursor_position.x_, cursor_position.y_ + viewport_height});
+        }
+        else
+        {
+            tracked_component_->event(keypress_event);
+        }
+    }
+
+    // ======================================================================
+    // MOUSE_EVENT
+    // ======================================================================
+    void mouse_event(terminalpp::mouse::event const &ev)
+    {
+        tracked_component_->event(terminalpp::mouse::event{
+            ev.action_, ev.position_ + anchor_bounds_.origin_});
+    }
+
     // ======================================================================
     // UPDATE_TRACKED_COMPONENT_SIZE
     // ======================================================================
@@ -281,6 +310,15 @@ struct viewport::impl
         }
     }
 
+    // ======================================================================
+    // CENSUS
+    // ======================================================================
+    void census(component_census &cen) const
+    {
+        cen.add_heap_bytes(typeid(self_), sizeof(*this));
+        tracked_component_->census(cen);
+    }
+
 private:
     // ======================================================================
     // ON_TRACKED_COMPONENT_CURSOR_POSITION_CHANGED
@@ -308,42 +346,18 @@ private:
     void on_tracked_component_redraw(
         std::vector<terminalpp::rectangle> const &regions)
     {
-        auto const viewport_size = self_.get_size();
+        // Regions from the tracked component are relative to its origin,
+        // and so must be translated by the anchor position and then clipped
+        // to the visible area of the viewport.
+        region damage{regions};
+        damage.translate(
+            {-anchor_bounds_.origin_.x_, -anchor_bounds_.origin_.y_});
+        damage &= terminalpp::rectangle{{}, self_.get_size()};
 
-        auto const translate_region =
-            [this](terminalpp::rectangle const &region) {
-                return terminalpp::rectangle{
-                    {region.origin_.x_ - anchor_bounds_.origin_.x_,
-                     region.origin_.y_ - anchor_bounds_.origin_.y_},
-                    region.size_
-                };
-            };
-
-        auto const clip_region =
-            [viewport_size](terminalpp::rectangle const &region) {
-                return terminalpp::rectangle{
-                    {region.origin_.x_, region.origin_.y_},
-                    {std::min(
-                         region.size_.width_,
-                     viewport_size.width_ - region.origin_.x_),
-                     std::min(
-                         region.size_.height_,
-                     viewport_size.height_ - region.origin_.y_)}
-                };
-            };
-
-        auto const region_is_in_viewable_area =
-            [viewport_size](terminalpp::rectangle const &region) {
-                return region.origin_.x_ < viewport_size.width_
-                    && region.origin_.y_ < viewport_size.height_;
-            };
-
-        using boost::adaptors::filtered;
-        using boost::adaptors::transformed;
-
-        self_.on_redraw(boost::copy_range<std::vector<terminalpp::rectangle>>(
-            regions | transformed(translate_region) | transformed(clip_region)
-            | filtered(region_is_in_viewable_area)));
+        if (!damage.empty())
+        {
+            self_.on_redraw(damage.rectangles());
+        }
     }
 
     viewport &self_;
@@ -478,6 +492,32 @@ void viewport::do_event(std::any const &event)
     pimpl_->event(event);
 }
 
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void viewport::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->key_event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void viewport::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->mouse_event(event);
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void viewport::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    cen.add_signal(typeid(*this), on_anchor_bounds_changed);
+    pimpl_->census(cen);
+}
+
 // ==========================================================================
 // MAKE_VIEWPORT
 // ==========================================================================
@@ -0,0 +1,796 @@
+#include "munin/virtual_container.hpp"
+
+#include "munin/component_census.hpp"
+#include "munin/detail/algorithm.hpp"
+#include "munin/render_surface.hpp"
+
+#include <boost/scope_exit.hpp>
+#include <terminalpp/mouse.hpp>
+#include <terminalpp/virtual_key.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace munin {
+
+// ==========================================================================
+// VIRTUAL_CONTAINER::IMPLEMENTATION STRUCTURE
+// ==========================================================================
+struct virtual_container::impl
+{
+    // ======================================================================
+    // CONSTRUCTOR
+    // ======================================================================
+    impl(
+        virtual_container &self,
+        row_factory factory,
+        std::size_t row_count,
+        terminalpp::coordinate_type row_height)
+      : self_(self),
+        factory_(std::move(factory)),
+        row_count_(row_count),
+        row_height_(std::max(row_height, terminalpp::coordinate_type{1})),
+        current_row_(
+            row_count == 0 ? std::nullopt : std::optional<std::size_t>{0})
+    {
+        // The current row has focus whenever this component does, so that
+        // any keypresses that are sent to it reach whichever of its own
+        // subcomponents has focus.
+        self_.on_focus_set.connect([this] { focus_current_row(); });
+        self_.on_focus_lost.connect([this] { unfocus_current_row(); });
+    }
+
+    // ======================================================================
+    // DESTRUCTOR
+    // ======================================================================
+    ~impl()
+    {
+        for (auto &[index, rw] : rows_)
+        {
+            disconnect(rw);
+        }
+    }
+
+    // ======================================================================
+    // SET_ROW_COUNT
+    // ======================================================================
+    void set_row_count(std::size_t row_count)
+    {
+        recycle_rows(rows_.lower_bound(row_count), rows_.end());
+        row_count_ = row_count;
+
+        set_current_row(
+            row_count_ == 0 ? std::nullopt
+            : current_row_  ? std::min(*current_row_, row_count_ - 1)
+                            : std::optional<std::size_t>{0});
+    }
+
+    // ======================================================================
+    // SET_CURRENT_ROW
+    // ======================================================================
+    void set_current_row(std::optional<std::size_t> current_row)
+    {
+        if (current_row_ != current_row)
+        {
+            unfocus_current_row();
+            current_row_ = current_row;
+            focus_current_row();
+
+            self_.on_cursor_position_changed();
+            self_.on_cursor_state_changed();
+        }
+    }
+
+    // ======================================================================
+    // REFRESH_ROWS
+    // ======================================================================
+    void refresh_rows()
+    {
+        recycle_rows(rows_.begin(), rows_.end());
+
+        // The current row was recycled along with the others, and so must
+        // be fetched again in order to keep the focus.
+        focus_current_row();
+    }
+
+    // ======================================================================
+    // MATERIALIZED_ROW_COUNT
+    // ======================================================================
+    [[nodiscard]] std::size_t materialized_row_count() const
+    {
+        return rows_.size();
+    }
+
+    // ======================================================================
+    // RESIZE_ROWS
+    // ======================================================================
+    void resize_rows()
+    {
+        for (auto &[index, rw] : rows_)
+        {
+            rw.component_->set_size({self_.get_size().width_, row_height_});
+        }
+    }
+
+    // ======================================================================
+    // GET_PREFERRED_SIZE
+    // ======================================================================
+    [[nodiscard]] terminalpp::extent get_preferred_size() const
+    {
+        return {0, rows_height()};
+    }
+
+    // ======================================================================
+    // GET_CURSOR_STATE
+    // ======================================================================
+    [[nodiscard]] bool get_cursor_state() const
+    {
+        auto const *comp = current_row_component();
+        return comp != nullptr && comp->get_cursor_state();
+    }
+
+    // ======================================================================
+    // GET_CURSOR_POSITION
+    // ======================================================================
+    [[nodiscard]] terminalpp::point get_cursor_position() const
+    {
+        if (!current_row_)
+        {
+            return {};
+        }
+
+        auto const *comp = current_row_component();
+        return row_origin(*current_row_)
+             + (comp != nullptr ? comp->get_cursor_position()
+                                : terminalpp::point{});
+    }
+
+    // ======================================================================
+    // SET_CURSOR_POSITION
+    // ======================================================================
+    void set_cursor_position(terminalpp::point const &position)
+    {
+        if (row_count_ != 0)
+        {
+            set_current_row(std::min(
+                static_cast<std::size_t>(
+                    std::max(position.y_ / row_height_, 0)),
+                row_count_ - 1));
+        }
+    }
+
+    // ======================================================================
+    // DRAW
+    // ======================================================================
+    void draw(render_surface &surface, terminalpp::rectangle const &region)
+    {
+        auto const region_top = std::max(region.origin_.y_, 0);
+        auto const region_bottom = region.origin_.y_ + region.size_.height_;
+        auto const rows_bottom = std::min(region_bottom, rows_height());
+
+        if (region_top < rows_bottom)
+        {
+            auto const first_row =
+                static_cast<std::size_t>(region_top / row_height_);
+            auto const last_row =
+                static_cast<std::size_t>((rows_bottom - 1) / row_height_);
+
+            // The rows that are drawn together are taken to be the rows
+            // that can be seen, and so the largest such set is the number
+            // of rows that is worth keeping.
+            ++draw_generation_;
+            row_capacity_ =
+                std::max(row_capacity_, last_row - first_row + 1);
+
+            // Rows that are about to be drawn are kept, and room is made for
+            // those that have yet to be created by recycling the rows that
+            // were drawn least recently, so that they can be reused.
+            std::size_t missing_rows = 0;
+
+            for (auto index = first_row; index <= last_row; ++index)
+            {
+                if (auto const existing = rows_.find(index);
+                    existing != rows_.end())
+                {
+                    existing->second.last_drawn_ = draw_generation_;
+                }
+                else
+                {
+                    ++missing_rows;
+                }
+            }
+
+            trim_rows(row_capacity_ - missing_rows);
+
+            for (auto index = first_row; index <= last_row; ++index)
+            {
+                auto &rw = materialize_row(index);
+                rw.last_drawn_ = draw_generation_;
+                draw_row(*rw.component_, index, surface, region);
+            }
+        }
+
+        // Anything below the last row is blank.
+        if (auto const blank_top = std::max(region_top, rows_height());
+            blank_top < region_bottom)
+        {
+            auto const blank_region = terminalpp::rectangle{
+                {region.origin_.x_,   blank_top                },
+                {region.size_.width_, region_bottom - blank_top}
+            };
+
+            surface.fill(blank_region, terminalpp::element{' '});
+        }
+    }
+
+    // ======================================================================
+    // EVENT
+    // ======================================================================
+    void event(std::any const &ev)
+    {
+        if (auto const *mouse = std::any_cast<terminalpp::mouse::event>(&ev);
+            mouse != nullptr)
+        {
+            mouse_event(*mouse);
+        }
+        else if (auto const *keypress =
+                     std::any_cast<terminalpp::virtual_key>(&ev);
+                 keypress != nullptr)
+        {
+            key_event(*keypress);
+        }
+        else if (current_row_)
+        {
+            auto const comp = materialize_row(*current_row_).component_;
+            comp->event(ev);
+        }
+    }
+
+    // ======================================================================
+    // KEY_EVENT
+    // ======================================================================
+    void key_event(terminalpp::virtual_key const &keypress)
+    {
+        if (!current_row_)
+        {
+            return;
+        }
+
+        switch (keypress.key)
+        {
+            case terminalpp::vk::cursor_up:
+                set_current_row(
+                    *current_row_ == 0 ? 0 : *current_row_ - 1);
+                break;
+
+            case terminalpp::vk::cursor_down:
+                set_current_row(std::min(*current_row_ + 1, row_count_ - 1));
+                break;
+
+            default:
+            {
+                // The map of rows is the only owner of the row, and the
+                // row's own handler may refresh or trim the rows, so a share
+                // of it is kept until the keypress has been handled.
+                auto const comp = materialize_row(*current_row_).component_;
+                comp->event(keypress);
+                break;
+            }
+        }
+    }
+
+    // ======================================================================
+    // MOUSE_EVENT
+    // ======================================================================
+    void mouse_event(terminalpp::mouse::event const &ev)
+    {
+        if (ev.position_.y_ < 0)
+        {
+            return;
+        }
+
+        auto const index =
+            static_cast<std::size_t>(ev.position_.y_ / row_height_);
+
+        if (index < row_count_)
+        {
+            set_current_row(index);
+
+            auto const origin = row_origin(index);
+            auto const comp = materialize_row(index).component_;
+            comp->event(terminalpp::mouse::event{
+                ev.action_,
+                {ev.position_.x_ - origin.x_, ev.position_.y_ - origin.y_}
+            });
+        }
+    }
+
+    // ======================================================================
+    // CENSUS
+    // ======================================================================
+    void census(component_census &cen) const
+    {
+        // Each node of the map of rows holds the row and three links.
+        cen.add_heap_bytes(
+            typeid(self_),
+            sizeof(*this)
+                + rows_.size()
+                      * (sizeof(decltype(rows_)::value_type)
+                         + 3 * sizeof(void *)
+                         + 3 * sizeof(connection))
+                + recycled_rows_.capacity()
+                      * sizeof(std::shared_ptr<component>));
+
+        for (auto const &[index, rw] : rows_)
+        {
+            rw.component_->census(cen);
+        }
+
+        for (auto const &recycled : recycled_rows_)
+        {
+            recycled->census(cen);
+        }
+    }
+
+    virtual_container &self_;
+    row_factory factory_;
+    std::size_t row_count_;
+    terminalpp::coordinate_type row_height_;
+    std::optional<std::size_t> current_row_;
+
+private:
+    struct row
+    {
+        std::shared_ptr<component> component_;
+        std::vector<connection> connections_;
+        std::uint64_t last_drawn_ = 0;
+    };
+
+    using row_map = std::map<std::size_t, row>;
+
+    // ======================================================================
+    // DISCONNECT
+    // ======================================================================
+    static void disconnect(row &rw)
+    {
+        for (auto &cnx : rw.connections_)
+        {
+            cnx.disconnect();
+        }
+    }
+
+    // ======================================================================
+    // CURRENT_ROW_COMPONENT
+    // ======================================================================
+    [[nodiscard]] component const *current_row_component() const
+    {
+        if (!current_row_)
+        {
+            return nullptr;
+        }
+
+        auto const existing = rows_.find(*current_row_);
+        return existing == rows_.end() ? nullptr
+                                       : existing->second.component_.get();
+    }
+
+    // ======================================================================
+    // FOCUS_CURRENT_ROW
+    // ======================================================================
+    void focus_current_row()
+    {
+        if (current_row_ && self_.has_focus())
+        {
+            materialize_row(*current_row_).component_->set_focus();
+        }
+    }
+
+    // ======================================================================
+    // UNFOCUS_CURRENT_ROW
+    // ======================================================================
+    void unfocus_current_row()
+    {
+        if (!current_row_)
+        {
+            return;
+        }
+
+        if (auto const existing = rows_.find(*current_row_);
+            existing != rows_.end() && existing->second.component_->has_focus())
+        {
+            existing->second.component_->lose_focus();
+        }
+    }
+
+    // ======================================================================
+    // ROW_ORIGIN
+    // ======================================================================
+    [[nodiscard]] terminalpp::point row_origin(std::size_t index) const
+    {
+        return {
+            0, static_cast<terminalpp::coordinate_type>(index) * row_height_};
+    }
+
+    // ======================================================================
+    // ROWS_HEIGHT
+    // ======================================================================
+    [[nodiscard]] terminalpp::coordinate_type rows_height() const
+    {
+        return static_cast<terminalpp::coordinate_type>(row_count_)
+             * row_height_;
+    }
+
+    // ======================================================================
+    // MATERIALIZE_ROW
+    // ======================================================================
+    row &materialize_row(std::size_t index)
+    {
+        if (auto const existing = rows_.find(index); existing != rows_.end())
+        {
+            return existing->second;
+        }
+
+        std::shared_ptr<component> recycled;
+
+        if (!recycled_rows_.empty())
+        {
+            recycled = std::move(recycled_rows_.back());
+            recycled_rows_.pop_back();
+        }
+
+        auto comp = factory_(index, std::move(recycled));
+        comp->set_position(row_origin(index));
+        comp->set_size({self_.get_size().width_, row_height_});
+
+        // The current row takes the focus if this component has it.  This is
+        // done before the row is connected, so that its own announcement of
+        // the change is not passed on.
+        if (index == current_row_ && self_.has_focus())
+        {
+            comp->set_focus();
+        }
+
+        // The row is only connected once it has been laid out, so that any
+        // redraws caused by laying it out are not announced.  Changes to
+        // its cursor are only announced while it is the current row.
+        std::vector<connection> cnx;
+        cnx.reserve(3);
+
+        cnx.push_back(comp->on_redraw.connect(
+            [this, index](auto const &regions) {
+                on_row_redraw(index, regions);
+            }));
+
+        cnx.push_back(comp->on_cursor_state_changed.connect([this, index] {
+            if (index == current_row_)
+            {
+                self_.on_cursor_state_changed();
+            }
+        }));
+
+        cnx.push_back(comp->on_cursor_position_changed.connect([this, index] {
+            if (index == current_row_)
+            {
+                self_.on_cursor_position_changed();
+            }
+        }));
+
+        return rows_
+            .emplace(index, row{std::move(comp), std::move(cnx), 0})
+            .first->second;
+    }
+
+    // ======================================================================
+    // RECYCLE_ROWS
+    // ======================================================================
+    void recycle_rows(row_map::iterator first, row_map::iterator last)
+    {
+        for (auto current = first; current != last; ++current)
+        {
+            // A recycled row must not keep the focus, since it may be reused
+            // for a row that is not current.
+            disconnect(current->second);
+
+            if (current->second.component_->has_focus())
+            {
+                current->second.component_->lose_focus();
+            }
+
+            if (recycled_rows_.size() < row_capacity_)
+            {
+                recycled_rows_.push_back(
+                    std::move(current->second.component_));
+            }
+        }
+
+        rows_.erase(first, last);
+    }
+
+    // ======================================================================
+    // TRIM_ROWS
+    // ======================================================================
+    void trim_rows(std::size_t rows_to_keep)
+    {
+        if (rows_.size() <= rows_to_keep)
+        {
+            return;
+        }
+
+        std::vector<row_map::iterator> candidates;
+        candidates.reserve(rows_.size());
+
+        // The current row is kept while it has focus, since recycling it
+        // would discard whatever the user was in the middle of doing there.
+        auto const keep_current = self_.has_focus();
+
+        for (auto current = rows_.begin(); current != rows_.end(); ++current)
+        {
+            if (!(keep_current && current->first == current_row_))
+            {
+                candidates.push_back(current);
+            }
+        }
+
+        auto const surplus =
+            std::min(rows_.size() - rows_to_keep, candidates.size());
+        std::ranges::nth_element(
+            candidates,
+            candidates.begin() + static_cast<std::ptrdiff_t>(surplus),
+            {},
+            [](auto const &candidate) {
+                return candidate->second.last_drawn_;
+            });
+
+        for (std::size_t index = 0; index < surplus; ++index)
+        {
+            recycle_rows(candidates[index], std::next(candidates[index]));
+        }
+    }
+
+    // ======================================================================
+    // DRAW_ROW
+    // ======================================================================
+    void draw_row(
+        component const &comp,
+        std::size_t index,
+        render_surface &surface,
+        terminalpp::rectangle const &region) const
+    {
+        auto const row_region = terminalpp::rectangle{
+            row_origin(index), {self_.get_size().width_, row_height_}
+        };
+
+        render_surface::scoped_clip const clip{surface, row_region};
+
+        if (auto draw_region =
+                detail::intersection(surface.clip_rect(), region);
+            draw_region)
+        {
+            draw_region->origin_ -= row_region.origin_;
+
+            surface.offset_by({row_region.origin_.x_, row_region.origin_.y_});
+
+            BOOST_SCOPE_EXIT_ALL(&surface, &row_region)
+            {
+                surface.offset_by(
+                    {-row_region.origin_.x_, -row_region.origin_.y_});
+            };
+
+            comp.draw(surface, draw_region.value());
+        }
+    }
+
+    // ======================================================================
+    // ON_ROW_REDRAW
+    // ======================================================================
+    void on_row_redraw(
+        std::size_t index, std::vector<terminalpp::rectangle> const &regions)
+    {
+        auto const origin = row_origin(index);
+        std::vector<terminalpp::rectangle> translated;
+        translated.reserve(regions.size());
+
+        for (auto const &region : regions)
+        {
+            translated.push_back({region.origin_ + origin, region.size_});
+        }
+
+        self_.on_redraw(translated);
+    }
+
+    row_map rows_;
+    std::vector<std::shared_ptr<component>> recycled_rows_;
+    std::size_t row_capacity_ = 1;
+    std::uint64_t draw_generation_ = 0;
+};
+
+// ==========================================================================
+// CONSTRUCTOR
+// ==========================================================================
+virtual_container::virtual_container(
+    row_factory factory,
+    std::size_t row_count,
+    terminalpp::coordinate_type row_height)
+  : pimpl_(std::make_unique<impl>(
+        *this, std::move(factory), row_count, row_height))
+{
+}
+
+// ==========================================================================
+// DESTRUCTOR
+// ==========================================================================
+virtual_container::~virtual_container() = default;
+
+// ==========================================================================
+// GET_ROW_COUNT
+// ==========================================================================
+std::size_t virtual_container::get_row_count() const
+{
+    return pimpl_->row_count_;
+}
+
+// ==========================================================================
+// SET_ROW_COUNT
+// ==========================================================================
+void virtual_container::set_row_count(std::size_t row_count)
+{
+    pimpl_->set_row_count(row_count);
+    on_preferred_size_changed();
+    on_redraw({
+        {{}, get_size()}
+    });
+}
+
+// ==========================================================================
+// GET_ROW_HEIGHT
+// ==========================================================================
+terminalpp::coordinate_type virtual_container::get_row_height() const
+{
+    return pimpl_->row_height_;
+}
+
+// ==========================================================================
+// GET_CURRENT_ROW
+// ==========================================================================
+std::optional<std::size_t> virtual_container::get_current_row() const
+{
+    return pimpl_->current_row_;
+}
+
+// ==========================================================================
+// REFRESH_ROWS
+// ==========================================================================
+void virtual_container::refresh_rows()
+{
+    pimpl_->refresh_rows();
+    on_redraw({
+        {{}, get_size()}
+    });
+}
+
+// ==========================================================================
+// GET_MATERIALIZED_ROW_COUNT
+// ==========================================================================
+std::size_t virtual_container::get_materialized_row_count() const
+{
+    return pimpl_->materialized_row_count();
+}
+
+// ==========================================================================
+// DO_SET_SIZE
+// ==========================================================================
+void virtual_container::do_set_size(terminalpp::extent const &size)
+{
+    basic_component::do_set_size(size);
+    pimpl_->resize_rows();
+}
+
+// ==========================================================================
+// DO_GET_PREFERRED_SIZE
+// ==========================================================================
+terminalpp::extent virtual_container::do_get_preferred_size() const
+{
+    return pimpl_->get_preferred_size();
+}
+
+// ==========================================================================
+// DO_GET_CURSOR_STATE
+// ==========================================================================
+bool virtual_container::do_get_cursor_state() const
+{
+    return pimpl_->get_cursor_state();
+}
+
+// ==========================================================================
+// DO_GET_CURSOR_POSITION
+// ==========================================================================
+terminalpp::point virtual_container::do_get_cursor_position() const
+{
+    return pimpl_->get_cursor_position();
+}
+
+// ==========================================================================
+// DO_SET_CURSOR_POSITION
+// ==========================================================================
+void virtual_container::do_set_cursor_position(
+    terminalpp::point const &position)
+{
+    pimpl_->set_cursor_position(position);
+}
+
+// ==========================================================================
+// DO_DRAW
+// ==========================================================================
+void virtual_container::do_draw(
+    render_surface &surface, terminalpp::rectangle const &region) const
+{
+    pimpl_->draw(surface, region);
+}
+
+// ==========================================================================
+// DO_EVENT
+// ==========================================================================
+void virtual_container::do_event(std::any const &ev)
+{
+    pimpl_->event(ev);
+}
+
+// ==========================================================================
+// DO_KEY_EVENT
+// ==========================================================================
+void virtual_container::do_key_event(terminalpp::virtual_key const &event)
+{
+    pimpl_->key_event(event);
+}
+
+// ==========================================================================
+// DO_MOUSE_EVENT
+// ==========================================================================
+void virtual_container::do_mouse_event(terminalpp::mouse::event const &event)
+{
+    pimpl_->mouse_event(event);
+}
+
+// ==========================================================================
+// DO_TO_JSON
+// ==========================================================================
+nlohmann::json virtual_container::do_to_json() const
+{
+    nlohmann::json patch = R"([
+        { "op": "replace", "path": "/type", "value": "virtual_container" }
+    ])"_json;
+
+    auto json = basic_component::do_to_json().patch(patch);
+
+    json["row_count"] = pimpl_->row_count_;
+    json["row_height"] = pimpl_->row_height_;
+    json["materialized_rows"] = pimpl_->materialized_row_count();
+
+    return json;
+}
+
+// ==========================================================================
+// DO_CENSUS
+// ==========================================================================
+void virtual_container::do_census(component_census &cen) const
+{
+    basic_component::do_census(cen);
+    pimpl_->census(cen);
+}
+
+// ==========================================================================
+// MAKE_VIRTUAL_CONTAINER
+// ==========================================================================
+std::shared_ptr<virtual_container> make_virtual_container(
+    virtual_container::row_factory factory,
+    std::size_t row_count,
+    terminalpp::coordinate_type row_height)
+{
+    return std::make_shared<virtual_container>(
+        std::move(factory), row_count, row_height);
+}
+
+}  // namespace munin
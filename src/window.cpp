@@ -1,10 +1,150 @@
 #include "munin/window.hpp"
 
+#include "munin/detail/row_compare.hpp"
+#include "munin/redraw_transaction.hpp"
 #include "munin/render_surface.hpp"
 
 #include <terminalpp/terminal.hpp>
 
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
 namespace munin {
+namespace {
+
+// ==========================================================================
+// WRITE_AT
+// ==========================================================================
+void write_at(
+    terminalpp::terminal &terminal,
+    terminalpp::point const &position,
+    terminalpp::string const &text)
+{
+    terminal << terminalpp::move_cursor(position) << text;
+}
+
+// ==========================================================================
+// WRITE_FRAME
+// ==========================================================================
+void write_frame(
+    terminalpp::terminal &terminal,
+    terminalpp::canvas const &cvs)
+{
+    auto const size = cvs.size();
+
+    for (terminalpp::coordinate_type row = 0; row < size.height_; ++row)
+    {
+        terminalpp::string line;
+
+        for (terminalpp::coordinate_type column = 0; column < size.width_;
+             ++column)
+        {
+            line += cvs[column][row];
+        }
+
+        write_at(terminal, {0, row}, line);
+    }
+}
+
+// ==========================================================================
+// WRITE_CHANGED_CELLS
+// ==========================================================================
+std::uint64_t write_changed_cells(
+    terminalpp::terminal &terminal,
+    terminalpp::canvas const &cvs,
+    compact_canvas &last_frame,
+    terminalpp::rectangle const &rect,
+    std::vector<compact_canvas::cell> &current)
+{
+    auto const width = static_cast<std::size_t>(rect.size_.width_);
+    auto const bottom = rect.origin_.y_ + rect.size_.height_;
+    std::uint64_t cells_changed = 0;
+
+    auto const canvas_column = [&rect](std::size_t index) {
+        return rect.origin_.x_
+             + static_cast<terminalpp::coordinate_type>(index);
+    };
+
+    current.resize(width);
+
+    for (auto row = rect.origin_.y_; row < bottom; ++row)
+    {
+        // The canvas is stored row by row, and so the elements in this row
+        // of the rectangle are contiguous.  Encoding them in the same way
+        // as the last frame allows whole rows to be compared quickly,
+        // although encoding them costs far more than comparing them.  This
+        // is why only the cells changed by drawing are passed here when the
+        // same canvas is repainted.
+        auto const elements = std::span<terminalpp::element const>{
+            &cvs[rect.origin_.x_][row], width};
+        auto const previous =
+            last_frame.row(row).subspan(rect.origin_.x_, width);
+
+        last_frame.encode(elements, current);
+
+        auto const difference = detail::compare_row(current, previous);
+
+        if (!difference)
+        {
+            continue;
+        }
+
+        auto column = difference->first_;
+
+        while (column < difference->last_)
+        {
+            if (current[column] == previous[column])
+            {
+                ++column;
+                continue;
+            }
+
+            // Gather consecutive changed cells so that they can be written
+            // out with a single cursor movement.
+            auto const first_column = canvas_column(column);
+            terminalpp::string changes;
+
+            do
+            {
+                changes += elements[column];
+                ++column;
+            } while (column < difference->last_
+                     && current[column] != previous[column]);
+
+            write_at(terminal, {first_column, row}, changes);
+            cells_changed += changes.size();
+        }
+
+        // Only the cells within the range of the difference need to be
+        // stored, since all of the others are the same.
+        auto const changed_cells =
+            std::span<compact_canvas::cell const>{current}.subspan(
+                difference->first_, difference->last_ - difference->first_);
+
+        last_frame.store(
+            {canvas_column(difference->first_), row}, changed_cells);
+    }
+
+    return cells_changed;
+}
+
+}  // namespace
+
+// ==========================================================================
+// IDENTIFY
+// ==========================================================================
+window::canvas_identity window::identify(terminalpp::canvas const &cvs)
+{
+    auto const size = cvs.size();
+
+    return {
+        &cvs,
+        size.width_ > 0 && size.height_ > 0 ? &cvs[0][0] : nullptr,
+        size};
+}
 
 // ==========================================================================
 // CONSTRUCTOR
@@ -22,15 +162,20 @@ window::window(
     terminalpp::terminal &terminal,
     std::shared_ptr<component> content,
     render_surface_capabilities const &capabilities)
-  : content_(std::move(content)), screen_{terminal}, capabilities_(capabilities)
+  : content_(std::move(content)),
+    terminal_(terminal),
+    capabilities_(capabilities)
 {
     auto const &request_repaint = [this](auto const &regions) {
-        bool first_request = repaint_regions_.empty();
+        ++statistics_.repaint_requests;
+        statistics_.regions_requested += regions.size();
 
-        repaint_regions_.insert(
-            repaint_regions_.end(), regions.begin(), regions.end());
+        for (auto const &rect : regions)
+        {
+            repaint_region_ |= rect;
+        }
 
-        if (first_request)
+        if (!std::exchange(repaint_requested_, true))
         {
             this->on_repaint_request();
         }
@@ -49,6 +194,27 @@ window::~window() = default;
 // ==========================================================================
 void window::event(std::any const &ev)
 {
+    // Any redraws caused by the event are gathered together and passed up
+    // the component tree once the event has been handled.
+    redraw_transaction const transaction;
+    content_->event(ev);
+}
+
+// ==========================================================================
+// EVENT
+// ==========================================================================
+void window::event(terminalpp::virtual_key const &ev)
+{
+    redraw_transaction const transaction;
+    content_->event(ev);
+}
+
+// ==========================================================================
+// EVENT
+// ==========================================================================
+void window::event(terminalpp::mouse::event const &ev)
+{
+    redraw_transaction const transaction;
     content_->event(ev);
 }
 
@@ -57,28 +223,142 @@ void window::event(std::any const &ev)
 // ==========================================================================
 void window::repaint(terminalpp::canvas &cvs)
 {
-    auto const canvas_size = cvs.size();
+    auto const canvas_bounds = terminalpp::rectangle{{}, cvs.size()};
 
-    std::vector<terminalpp::rectangle> repaint_regions;
+    region repaint_region;
+    std::swap(repaint_region, repaint_region_);
+    repaint_requested_ = false;
 
     if (cvs.size() != content_->get_size())
     {
         content_->set_size(cvs.size());
-        repaint_regions.clear();
-        repaint_regions.push_back({{}, canvas_size});
+        repaint_region = canvas_bounds;
     }
     else
     {
-        repaint_regions.swap(repaint_regions_);
+        repaint_region &= canvas_bounds;
+    }
+
+    // Since the region is a set of non-overlapping rectangles, each cell is
+    // drawn at most once, no matter how many times it was requested.
+    auto const draw_start = std::chrono::steady_clock::now();
+    dirty_.reset(cvs.size());
+    render_surface surface(cvs, capabilities_, dirty_);
+    auto const rectangles = repaint_region.rectangles();
+
+    for (auto const &rect : rectangles)
+    {
+        content_->draw(surface, rect);
     }
 
-    render_surface surface(cvs, capabilities_);
-    for (auto const &region : repaint_regions)
+    auto const paint_start = std::chrono::steady_clock::now();
+    auto const bytes_before = bytes_written_ ? bytes_written_() : 0;
+
+    if (begin_batch_)
     {
-        content_->draw(surface, region);
+        begin_batch_();
     }
 
-    screen_.draw(cvs);
+    if (!last_frame_ || last_frame_->size() != cvs.size())
+    {
+        // There is no previous frame of the same size to compare against,
+        // so the entire canvas must be painted.
+        write_frame(terminal_, cvs);
+        last_frame_.emplace(cvs);
+        statistics_.cells_changed += canvas_bounds.size_.width_
+                                   * canvas_bounds.size_.height_;
+    }
+    else
+    {
+        // Otherwise, only cells within the damaged region can have changed
+        // since the last frame, so only those need to be compared.  If the
+        // canvas is the one that was painted last time, then it already
+        // held the last frame, and the surface has recorded exactly which
+        // of its cells were changed by drawing.
+        auto const changed_rectangles = identify(cvs) == last_canvas_
+                                          ? dirty_.rectangles()
+                                          : rectangles;
+
+        std::vector<compact_canvas::cell> current;
+
+        for (auto const &rect : changed_rectangles)
+        {
+            statistics_.cells_changed += write_changed_cells(
+                terminal_, cvs, *last_frame_, rect, current);
+        }
+
+        // Overwritten cells may have left glyphs and attributes in the
+        // tables of the last frame that nothing uses any more.
+        last_frame_->compact();
+    }
+
+    if (end_batch_)
+    {
+        end_batch_();
+    }
+
+    last_canvas_ = identify(cvs);
+
+    auto const paint_end = std::chrono::steady_clock::now();
+
+    ++statistics_.repaints;
+    statistics_.regions_drawn += rectangles.size();
+    statistics_.region_area += repaint_region.area();
+    statistics_.cells_written += surface.cells_written();
+
+    if (bytes_written_)
+    {
+        statistics_.bytes_emitted += bytes_written_() - bytes_before;
+    }
+
+    statistics_.draw_time += paint_start - draw_start;
+    statistics_.paint_time += paint_end - paint_start;
+}
+
+// ==========================================================================
+// STATISTICS
+// ==========================================================================
+window_statistics const &window::statistics() const
+{
+    return statistics_;
+}
+
+// ==========================================================================
+// MEASURE_OUTPUT
+// ==========================================================================
+void window::measure_output(std::function<std::uint64_t()> bytes_written)
+{
+    bytes_written_ = std::move(bytes_written);
+}
+
+// ==========================================================================
+// BATCH_OUTPUT
+// ==========================================================================
+void window::batch_output(
+    std::function<void()> begin_batch, std::function<void()> end_batch)
+{
+    begin_batch_ = std::move(begin_batch);
+    end_batch_ = std::move(end_batch);
+}
+
+// ==========================================================================
+// CENSUS
+// ==========================================================================
+component_census window::census() const
+{
+    component_census cen;
+    cen.add_instance(typeid(window));
+    cen.add_signal(typeid(window), on_repaint_request);
+
+    // The last frame is kept for the lifetime of the window, and so is
+    // usually the largest single allocation in a session.
+    if (last_frame_)
+    {
+        cen.add_heap_bytes(typeid(window), last_frame_->heap_bytes());
+    }
+
+    content_->census(cen);
+    return cen;
 }
 
 // ==========================================================================
@@ -86,9 +366,28 @@ void window::repaint(terminalpp::canvas &cvs)
 // ==========================================================================
 nlohmann::json window::to_json() const
 {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    nlohmann::json statistics_json = {
+        {"repaint_requests",  statistics_.repaint_requests },
+        {"repaints",          statistics_.repaints         },
+        {"regions_requested", statistics_.regions_requested},
+        {"regions_drawn",     statistics_.regions_drawn    },
+        {"region_area",       statistics_.region_area      },
+        {"cells_written",     statistics_.cells_written    },
+        {"cells_changed",     statistics_.cells_changed    },
+        {"bytes_emitted",     statistics_.bytes_emitted    },
+        {"draw_time_us",
+         duration_cast<microseconds>(statistics_.draw_time).count() },
+        {"paint_time_us",
+         duration_cast<microseconds>(statistics_.paint_time).count()}
+    };
+
     return {
-        {"type",    "window"           },
-        {"content", content_->to_json()}
+        {"type",       "window"                  },
+        {"content",    content_->to_json()       },
+        {"statistics", std::move(statistics_json)}
     };
 }
 
@@ -21,6 +21,7 @@ struct fake_channel
     void write(terminalpp::bytes data)
     {
         written.append(data.begin(), data.end());
+        ++writes;
     }
 
     //* =================================================================
@@ -60,5 +61,6 @@ struct fake_channel
 
     std::function<void(terminalpp::bytes)> read_callback;
     terminalpp::byte_storage written;
+    int writes{0};
     bool alive{true};
 };
\ No newline at end of file
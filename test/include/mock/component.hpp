@@ -125,9 +125,36 @@ public:
     /// in a custom manner.
     //* =====================================================================
     MOCK_CONST_METHOD0(do_to_json, nlohmann::json());
+
+    //* =====================================================================
+    /// \brief Called by is_opaque().  Derived classes may override this
+    /// function in order to declare that they always draw over every cell
+    /// within their bounds.
+    //* =====================================================================
+    MOCK_CONST_METHOD0(do_is_opaque, bool());
 };
 
 //* =========================================================================
 /// \brief Makes a mock component
 //* =========================================================================
 std::shared_ptr<mock_component> make_mock_component();
+
+//* =========================================================================
+/// \brief Gives a mock component a position and size that no layout would
+/// give it.  Since setting a component's position or size to what it
+/// already is does nothing, this makes every placement of the component
+/// observable, including placement at the origin or at zero size.
+//* =========================================================================
+template <class MockComponent>
+void unplace(MockComponent &comp)
+{
+    using testing::AnyNumber;
+    using testing::Return;
+
+    EXPECT_CALL(comp, do_get_position())
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(terminalpp::point{-1, -1}));
+    EXPECT_CALL(comp, do_get_size())
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(terminalpp::extent{-1, -1}));
+}
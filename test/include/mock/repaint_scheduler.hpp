@@ -0,0 +1,27 @@
+#pragma once
+#include <gmock/gmock.h>
+#include <munin/repaint_scheduler.hpp>
+
+class mock_repaint_scheduler : public munin::repaint_scheduler
+{
+public:
+    //* =====================================================================
+    /// \brief Schedules start_frame() to be called at a certain time.
+    //* =====================================================================
+    MOCK_METHOD1(reset_timer, void(std::chrono::steady_clock::time_point));
+
+    //* =====================================================================
+    /// \brief Returns the current time
+    //* =====================================================================
+    MOCK_CONST_METHOD0(do_now, std::chrono::steady_clock::time_point());
+
+    //* =====================================================================
+    /// \brief Starts a frame
+    //* =====================================================================
+    using munin::repaint_scheduler::start_frame;
+};
+
+//* =========================================================================
+/// \brief Makes a mock repaint scheduler
+//* =========================================================================
+std::shared_ptr<mock_repaint_scheduler> make_mock_repaint_scheduler();
@@ -60,6 +60,7 @@ TEST_P(aligned_layouts, place_components_at_these_positions)
     auto const &expected_placement = std::get<3>(param);
 
     auto component = std::make_shared<mock_component>();
+    unplace(*component);
     EXPECT_CALL(*component, do_get_preferred_size())
         .WillRepeatedly(Return(component_size));
     EXPECT_CALL(*component, do_set_position(expected_placement.origin_));
@@ -113,3 +113,24 @@ TEST(
         },
         canvas);
 }
+
+TEST(a_brush, is_opaque)
+{
+    munin::brush brush("abc"_ts);
+
+    ASSERT_TRUE(brush.is_opaque());
+}
+
+TEST(a_brush_with_an_empty_pattern, is_not_opaque)
+{
+    munin::brush brush(std::vector<terminalpp::string>{});
+
+    ASSERT_FALSE(brush.is_opaque());
+}
+
+TEST(a_brush_with_an_empty_line_in_its_pattern, is_not_opaque)
+{
+    munin::brush brush(std::vector<terminalpp::string>{"abc"_ts, ""_ts});
+
+    ASSERT_FALSE(brush.is_opaque());
+}
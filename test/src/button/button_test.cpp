@@ -112,6 +112,32 @@ TEST_P(a_button, emits_on_click)
     ASSERT_EQ(click_should_be_received, click_received);
 }
 
+TEST_P(a_button, emits_on_click_for_unboxed_events)
+{
+    auto const &event = std::get<0>(GetParam());
+    auto const &click_should_be_received = std::get<1>(GetParam());
+
+    bool click_received = false;
+    button_.on_click.connect([&click_received] { click_received = true; });
+
+    if (auto const *vk = std::any_cast<terminalpp::virtual_key>(&event); vk)
+    {
+        button_.event(*vk);
+    }
+    else if (auto const *mouse =
+                 std::any_cast<terminalpp::mouse::event>(&event);
+             mouse)
+    {
+        button_.event(*mouse);
+    }
+    else
+    {
+        button_.event(event);
+    }
+
+    ASSERT_EQ(click_should_be_received, click_received);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     a_button_emits_on_click_for_certain_events,
     a_button,
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <munin/compact_canvas.hpp>
+
+#include <cstdint>
+#include <utility>
+
+TEST(a_new_compact_canvas, has_default_elements)
+{
+    munin::compact_canvas const cvs{
+        terminalpp::extent{3, 2}
+    };
+
+    ASSERT_EQ((terminalpp::extent{3, 2}), cvs.size());
+    ASSERT_EQ(terminalpp::element{}, cvs.get({0, 0}));
+    ASSERT_EQ(terminalpp::element{}, cvs.get({2, 1}));
+    ASSERT_EQ(1U, cvs.palette_size());
+}
+
+TEST(a_compact_canvas, stores_cells_in_eight_bytes)
+{
+    ASSERT_EQ(8U, sizeof(munin::compact_canvas::cell));
+}
+
+TEST(a_compact_canvas, round_trips_a_terminalpp_canvas)
+{
+    terminalpp::canvas cvs{
+        {3, 2}
+    };
+
+    auto bold = terminalpp::attribute{};
+    bold.intensity_ = terminalpp::graphics::intensity::bold;
+
+    cvs[0][0] = 'a';
+    cvs[1][0] = terminalpp::element{'b', bold};
+    cvs[2][1] = terminalpp::element{terminalpp::glyph{u8"\U00002501"}, bold};
+
+    munin::compact_canvas const compact{cvs};
+
+    ASSERT_EQ(cvs.size(), compact.size());
+    ASSERT_EQ(cvs[0][0], compact.get({0, 0}));
+    ASSERT_EQ(cvs[1][0], compact.get({1, 0}));
+    ASSERT_EQ(cvs[2][1], compact.get({2, 1}));
+
+    auto const expanded = compact.to_canvas();
+
+    for (terminalpp::coordinate_type row = 0; row < 2; ++row)
+    {
+        for (terminalpp::coordinate_type column = 0; column < 3; ++column)
+        {
+            ASSERT_EQ(cvs[column][row], expanded[column][row]);
+        }
+    }
+}
+
+TEST(a_compact_canvas, shares_palette_entries_between_cells)
+{
+    terminalpp::canvas cvs{
+        {4, 4}
+    };
+
+    auto bold = terminalpp::attribute{};
+    bold.intensity_ = terminalpp::graphics::intensity::bold;
+
+    for (auto &elem : cvs)
+    {
+        elem = terminalpp::element{'x', bold};
+    }
+
+    munin::compact_canvas const compact{cvs};
+
+    ASSERT_EQ(2U, compact.palette_size());
+    ASSERT_EQ(0U, compact.glyph_table_size());
+}
+
+TEST(a_compact_canvas, updates_only_elements_that_differ)
+{
+    munin::compact_canvas cvs{
+        terminalpp::extent{2, 1}
+    };
+
+    ASSERT_FALSE(cvs.update({0, 0}, terminalpp::element{}));
+    ASSERT_TRUE(cvs.update({0, 0}, 'z'));
+    ASSERT_FALSE(cvs.update({0, 0}, 'z'));
+    ASSERT_EQ(terminalpp::element{'z'}, cvs.get({0, 0}));
+    ASSERT_EQ(terminalpp::element{}, cvs.get({1, 0}));
+}
+
+TEST(a_compacted_compact_canvas, drops_attributes_that_are_no_longer_used)
+{
+    munin::compact_canvas compact{
+        {2, 1}
+    };
+
+    terminalpp::element elem{'x'};
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        elem.attribute_.foreground_colour_ = terminalpp::true_colour{
+            static_cast<terminalpp::byte>(index % 256),
+            static_cast<terminalpp::byte>(index / 256),
+            0};
+        compact.set({0, 0}, elem);
+    }
+
+    ASSERT_EQ(1001U, compact.palette_size());
+
+    compact.compact();
+
+    ASSERT_EQ(2U, compact.palette_size());
+    ASSERT_EQ(elem, compact.get({0, 0}));
+    ASSERT_EQ(terminalpp::element{}, compact.get({1, 0}));
+}
+
+TEST(a_compact_canvas, counts_its_palette_and_its_index_in_its_heap_bytes)
+{
+    munin::compact_canvas compact{
+        {3, 2}
+    };
+
+    auto const initial_bytes = compact.heap_bytes();
+    ASSERT_GE(initial_bytes, 6 * sizeof(munin::compact_canvas::cell));
+
+    terminalpp::element elem{'x'};
+    elem.attribute_.intensity_ = terminalpp::graphics::intensity::bold;
+    compact.set({0, 0}, elem);
+
+    // The new attribute takes space both in the palette and in its index.
+    ASSERT_GE(
+        compact.heap_bytes(),
+        initial_bytes + sizeof(terminalpp::attribute)
+            + sizeof(std::pair<terminalpp::attribute const, std::uint32_t>));
+}
@@ -62,6 +62,7 @@ TEST_P(compass_layouts, place_components_at_these_positions)
         auto const &expected_placement = std::get<2>(component_datum);
 
         auto component = std::make_shared<mock_component>();
+        unplace(*component);
         EXPECT_CALL(*component, do_get_preferred_size())
             .WillRepeatedly(Return(preferred_size));
         EXPECT_CALL(*component, do_set_position(expected_placement.origin_));
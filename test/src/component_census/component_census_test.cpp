@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <munin/button.hpp>
+#include <munin/component_census.hpp>
+#include <munin/container.hpp>
+#include <munin/image.hpp>
+
+#include <string>
+
+using namespace terminalpp::literals;  // NOLINT
+
+namespace {
+
+munin::component_census take_census(munin::component const &comp)
+{
+    munin::component_census cen;
+    comp.census(cen);
+    return cen;
+}
+
+}  // namespace
+
+TEST(a_new_component_census, counts_nothing)
+{
+    munin::component_census const cen;
+
+    ASSERT_TRUE(cen.types().empty());
+    ASSERT_EQ(munin::component_census::entry{}, cen.totals());
+}
+
+TEST(a_component_census, counts_instances_heap_bytes_and_connections)
+{
+    munin::component_census cen;
+    cen.add_instance(typeid(int));
+    cen.add_instance(typeid(int));
+    cen.add_heap_bytes(typeid(int), 10);
+    cen.add_instance(typeid(double));
+
+    auto const expected_int = munin::component_census::entry{2, 10, 0};
+    auto const expected_double = munin::component_census::entry{1, 0, 0};
+    auto const expected_totals = munin::component_census::entry{3, 10, 0};
+
+    ASSERT_EQ(2u, cen.types().size());
+    ASSERT_EQ(expected_int, cen.types().at("int"));
+    ASSERT_EQ(expected_double, cen.types().at("double"));
+    ASSERT_EQ(expected_totals, cen.totals());
+}
+
+TEST(a_component_census, counts_the_slots_connected_to_a_signal)
+{
+    munin::signal<void()> sig;
+    sig.connect([] {});
+    sig.connect([] {});
+
+    munin::component_census cen;
+    cen.add_signal(typeid(int), sig);
+
+    ASSERT_EQ(2u, cen.types().at("int").connections);
+    ASSERT_EQ(
+        munin::component_census::estimate_signal_bytes(2),
+        cen.types().at("int").heap_bytes);
+}
+
+TEST(a_component_census, counts_an_image_with_its_content)
+{
+    auto const small_image = munin::make_image("a"_ts);
+    auto const large_image = munin::make_image("abcdefghijklmnop"_ts);
+
+    auto const small_census = take_census(*small_image);
+    auto const large_census = take_census(*large_image);
+
+    ASSERT_EQ(1u, small_census.types().size());
+    ASSERT_EQ(1u, small_census.types().at("munin::image").instances);
+    ASSERT_EQ(0u, small_census.types().at("munin::image").connections);
+    ASSERT_LT(
+        small_census.types().at("munin::image").heap_bytes,
+        large_census.types().at("munin::image").heap_bytes);
+}
+
+TEST(a_component_census, counts_a_container_with_its_layout_and_components)
+{
+    auto const image = munin::make_image("a"_ts);
+    munin::container container;
+    container.add_component(image);
+    container.add_component(munin::make_image("b"_ts));
+
+    auto const cen = take_census(container);
+
+    ASSERT_EQ(1u, cen.types().at("munin::container").instances);
+    ASSERT_EQ(1u, cen.types().at("munin::null_layout").instances);
+    ASSERT_EQ(2u, cen.types().at("munin::image").instances);
+    ASSERT_EQ(4u, cen.totals().instances);
+
+    // The container connects to the signals of each of its components.
+    ASSERT_NE(0u, cen.types().at("munin::image").connections);
+
+    container.remove_component(image);
+    ASSERT_EQ(0u, take_census(*image).totals().connections);
+}
+
+TEST(a_component_census, counts_the_components_that_make_up_a_button)
+{
+    auto const button = munin::make_button("OK");
+    auto const cen = take_census(*button);
+
+    ASSERT_EQ(1u, cen.types().at("munin::button").instances);
+    ASSERT_EQ(1u, cen.types().at("munin::framed_component").instances);
+    ASSERT_EQ(1u, cen.types().at("munin::solid_frame").instances);
+    ASSERT_EQ(1u, cen.types().at("munin::image").instances);
+    ASSERT_EQ(1u, cen.types().at("munin::grid_layout").instances);
+    ASSERT_LT(1u, cen.types().at("munin::container").instances);
+
+    std::size_t instances = 0;
+    std::size_t heap_bytes = 0;
+    std::size_t connections = 0;
+
+    for (auto const &[name, ent] : cen.types())
+    {
+        instances += ent.instances;
+        heap_bytes += ent.heap_bytes;
+        connections += ent.connections;
+    }
+
+    auto const expected_totals =
+        munin::component_census::entry{instances, heap_bytes, connections};
+    ASSERT_EQ(expected_totals, cen.totals());
+}
@@ -3,6 +3,11 @@
 #include <gtest/gtest.h>
 #include <munin/composite_component.hpp>
 #include <munin/grid_layout.hpp>
+#include <terminalpp/mouse.hpp>
+#include <terminalpp/virtual_key.hpp>
+
+#include <optional>
+#include <vector>
 
 using testing::_;
 using testing::Return;
@@ -95,3 +100,64 @@ TEST_F(a_composite_component, forwards_events_to_its_inner_component)
     composite_->event(value);
     ASSERT_EQ(value, received_value);
 }
+
+TEST_F(a_composite_component, forwards_keypresses_to_its_inner_component)
+{
+    std::optional<terminalpp::vk> received_key;
+
+    EXPECT_CALL(*composite_->inner_component, do_event(_))
+        .WillOnce([&received_key](std::any const &ev) {
+            received_key = std::any_cast<terminalpp::virtual_key>(ev).key;
+        });
+
+    composite_->set_focus();
+    ON_CALL(*composite_->inner_component, do_has_focus)
+        .WillByDefault(Return(true));
+
+    composite_->event(terminalpp::virtual_key{terminalpp::vk::enter});
+    ASSERT_EQ(terminalpp::vk::enter, received_key);
+}
+
+namespace {
+
+class event_handling_composite : public composite_mock
+{
+public:
+    std::vector<std::any> events;
+
+protected:
+    void do_event(std::any const &ev) override
+    {
+        events.push_back(ev);
+    }
+};
+
+}  // namespace
+
+TEST(a_composite_component_that_handles_events, receives_keypresses_in_do_event)
+{
+    event_handling_composite composite;
+
+    composite.event(terminalpp::virtual_key{terminalpp::vk::enter});
+
+    ASSERT_EQ(1u, composite.events.size());
+    ASSERT_EQ(
+        terminalpp::vk::enter,
+        std::any_cast<terminalpp::virtual_key>(composite.events[0]).key);
+}
+
+TEST(
+    a_composite_component_that_handles_events,
+    receives_mouse_events_in_do_event)
+{
+    event_handling_composite composite;
+
+    composite.event(terminalpp::mouse::event{
+        terminalpp::mouse::event_type::left_button_down, {0, 0}
+    });
+
+    ASSERT_EQ(1u, composite.events.size());
+    ASSERT_NE(
+        nullptr,
+        std::any_cast<terminalpp::mouse::event>(&composite.events[0]));
+}
@@ -1,6 +1,8 @@
 #include "container_test.hpp"
 
+#include <munin/brush.hpp>
 #include <munin/render_surface.hpp>
+#include <terminalpp/mouse.hpp>
 
 using testing::_;
 using testing::Return;
@@ -87,6 +89,60 @@ TEST_F(a_container, offsets_canvas_before_drawing_offset_components)
     container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
 }
 
+TEST_F(a_container, clips_subcomponents_to_their_bounds)
+{
+    auto component = std::make_shared<mock_component>();
+
+    container_.set_size({3, 2});
+
+    container_.add_component(component);
+
+    terminalpp::canvas canvas({3, 2});
+    munin::render_surface surface{canvas};
+
+    ON_CALL(*component, do_get_position())
+        .WillByDefault(Return(terminalpp::point(1, 0)));
+    ON_CALL(*component, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(1, 2)));
+
+    EXPECT_CALL(*component, do_draw(_, _))
+        .WillOnce(testing::Invoke(
+            [](munin::render_surface &surface, auto const &) {
+                surface.fill({{-1, 0}, {3, 2}}, 'x');
+                surface[1][1] = 'y';
+            }));
+
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {3, 2}));
+
+    ASSERT_TRUE(canvas[0][0] == ' ');
+    ASSERT_TRUE(canvas[1][0] == 'x');
+    ASSERT_TRUE(canvas[1][1] == 'x');
+    ASSERT_TRUE(canvas[2][0] == ' ');
+    ASSERT_TRUE(canvas[2][1] == ' ');
+}
+
+TEST_F(a_container, does_not_draw_subcomponents_outside_of_the_surface_clip)
+{
+    auto component = std::make_shared<mock_component>();
+
+    container_.set_size({2, 2});
+
+    container_.add_component(component);
+
+    terminalpp::canvas canvas({2, 2});
+    munin::render_surface surface{canvas};
+
+    ON_CALL(*component, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*component, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 1)));
+
+    EXPECT_CALL(*component, do_draw(_, _)).Times(0);
+
+    munin::render_surface::scoped_clip const clip{surface, {{0, 1}, {2, 1}}};
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
+}
+
 TEST_F(a_container, draws_many_components_when_drawing)
 {
     auto component_tl = std::make_shared<mock_component>();
@@ -133,3 +189,177 @@ TEST_F(a_container, draws_many_components_when_drawing)
 
     container_.draw(surface, terminalpp::rectangle({1, 1}, {2, 2}));
 }
+
+TEST_F(a_container_with_many_components, draws_only_components_in_the_region)
+{
+    terminalpp::canvas canvas({64, 1});
+    munin::render_surface surface{canvas};
+
+    for (std::size_t index = 0; index < components_.size(); ++index)
+    {
+        if (index == 20 || index == 21)
+        {
+            EXPECT_CALL(
+                *components_[index],
+                do_draw(_, terminalpp::rectangle({0, 0}, {1, 1})));
+        }
+        else
+        {
+            EXPECT_CALL(*components_[index], do_draw(_, _)).Times(0);
+        }
+    }
+
+    container_.draw(surface, terminalpp::rectangle({20, 0}, {2, 1}));
+}
+
+TEST_F(a_container, does_not_draw_components_hidden_by_opaque_components)
+{
+    auto lower = make_mock_component();
+    auto upper = make_mock_component();
+
+    ON_CALL(*lower, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*lower, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 2)));
+    ON_CALL(*upper, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*upper, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 2)));
+    ON_CALL(*upper, do_is_opaque()).WillByDefault(Return(true));
+
+    container_.set_size({2, 2});
+    container_.add_component(lower);
+    container_.add_component(upper);
+
+    terminalpp::canvas canvas({2, 2});
+    munin::render_surface surface{canvas};
+
+    EXPECT_CALL(*lower, do_draw(_, _)).Times(0);
+    EXPECT_CALL(*upper, do_draw(_, terminalpp::rectangle({0, 0}, {2, 2})));
+
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
+}
+
+TEST_F(
+    a_container, draws_only_the_parts_of_components_not_hidden_by_opaque_ones)
+{
+    auto lower = make_mock_component();
+    auto upper = make_mock_component();
+
+    ON_CALL(*lower, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*lower, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(4, 1)));
+    ON_CALL(*upper, do_get_position())
+        .WillByDefault(Return(terminalpp::point(1, 0)));
+    ON_CALL(*upper, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 1)));
+    ON_CALL(*upper, do_is_opaque()).WillByDefault(Return(true));
+
+    container_.set_size({4, 1});
+    container_.add_component(lower);
+    container_.add_component(upper);
+
+    terminalpp::canvas canvas({4, 1});
+    munin::render_surface surface{canvas};
+
+    EXPECT_CALL(*lower, do_draw(_, terminalpp::rectangle({0, 0}, {1, 1})));
+    EXPECT_CALL(*lower, do_draw(_, terminalpp::rectangle({3, 0}, {1, 1})));
+    EXPECT_CALL(*upper, do_draw(_, terminalpp::rectangle({0, 0}, {2, 1})));
+
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {4, 1}));
+}
+
+TEST_F(a_container, draws_components_beneath_brushes_with_empty_patterns)
+{
+    auto lower = make_mock_component();
+    auto upper =
+        std::make_shared<munin::brush>(std::vector<terminalpp::string>{});
+
+    ON_CALL(*lower, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*lower, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 2)));
+    upper->set_size({2, 2});
+
+    container_.set_size({2, 2});
+    container_.add_component(lower);
+    container_.add_component(upper);
+
+    terminalpp::canvas canvas({2, 2});
+    munin::render_surface surface{canvas};
+
+    // The brush draws nothing, so the component beneath it must still be
+    // drawn.
+    EXPECT_CALL(*lower, do_draw(_, terminalpp::rectangle({0, 0}, {2, 2})));
+
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
+}
+
+TEST_F(a_container, draws_components_beneath_transparent_components)
+{
+    auto lower = make_mock_component();
+    auto upper = make_mock_component();
+
+    ON_CALL(*lower, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*lower, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 2)));
+    ON_CALL(*upper, do_get_position())
+        .WillByDefault(Return(terminalpp::point(0, 0)));
+    ON_CALL(*upper, do_get_size())
+        .WillByDefault(Return(terminalpp::extent(2, 2)));
+
+    container_.set_size({2, 2});
+    container_.add_component(lower);
+    container_.add_component(upper);
+
+    terminalpp::canvas canvas({2, 2});
+    munin::render_surface surface{canvas};
+
+    EXPECT_CALL(*lower, do_draw(_, terminalpp::rectangle({0, 0}, {2, 2})));
+    EXPECT_CALL(*upper, do_draw(_, terminalpp::rectangle({0, 0}, {2, 2})));
+
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
+}
+
+TEST_F(
+    a_container_with_many_components,
+    finds_and_draws_a_component_moved_outside_of_its_layout)
+{
+    // The container has a null layout, so the component is moved only by
+    // being told to, after the spatial index has been built.
+    terminalpp::canvas canvas({64, 2});
+    munin::render_surface surface{canvas};
+
+    auto &moved = *components_[5];
+    terminalpp::point position{5, 0};
+    ON_CALL(moved, do_set_position(_))
+        .WillByDefault(
+            [&position](terminalpp::point const &pos) { position = pos; });
+    ON_CALL(moved, do_get_position()).WillByDefault([&position] {
+        return position;
+    });
+
+    container_.set_size({64, 2});
+    container_.event(terminalpp::mouse::event{
+        terminalpp::mouse::event_type::left_button_down, {63, 1}
+    });
+
+    moved.set_position({40, 1});
+
+    EXPECT_CALL(moved, do_event(_));
+    EXPECT_CALL(*components_[40], do_event(_)).Times(0);
+    container_.event(terminalpp::mouse::event{
+        terminalpp::mouse::event_type::left_button_down, {40, 1}
+    });
+
+    reset_counters();
+    moved.on_redraw({
+        {{0, 0}, {1, 1}}
+    });
+    ASSERT_EQ(1, redraw_count_);
+
+    EXPECT_CALL(moved, do_draw(_, terminalpp::rectangle({0, 0}, {1, 1})));
+    container_.draw(surface, terminalpp::rectangle({40, 1}, {1, 1}));
+}
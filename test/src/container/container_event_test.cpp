@@ -1,7 +1,11 @@
 #include "container_test.hpp"
 
+#include <munin/render_surface.hpp>
+#include <terminalpp/canvas.hpp>
 #include <terminalpp/mouse.hpp>
+#include <terminalpp/virtual_key.hpp>
 
+#include <memory>
 #include <tuple>
 #include <vector>
 
@@ -33,11 +37,27 @@ TEST_F(
     container_.event('X');
 }
 
+TEST_F(
+    a_container_with_one_component_that_has_focus,
+    forwards_unboxed_keypresses_to_the_subcomponent)
+{
+    EXPECT_CALL(*component_, do_has_focus()).WillOnce(Return(true));
+
+    EXPECT_CALL(*component_, do_event(_)).WillOnce([](std::any const &event) {
+        auto const *vk = std::any_cast<terminalpp::virtual_key>(&event);
+        ASSERT_NE(nullptr, vk);
+        ASSERT_EQ(terminalpp::vk::enter, vk->key);
+    });
+    container_.event(terminalpp::virtual_key{terminalpp::vk::enter});
+}
+
 TEST_F(
     a_container_with_two_components_where_the_last_has_focus,
-    skips_the_first_and_forwards_events_to_the_last_subcomponent)
+    forwards_events_to_the_last_subcomponent_without_checking_the_first)
 {
-    EXPECT_CALL(*component0_, do_has_focus()).WillOnce(Return(false));
+    // The container remembers which subcomponent has focus, so it does not
+    // need to search for it.
+    EXPECT_CALL(*component0_, do_has_focus()).Times(0);
 
     EXPECT_CALL(*component1_, do_has_focus()).WillOnce(Return(true));
 
@@ -49,6 +69,35 @@ TEST_F(
     container_.event('X');
 }
 
+TEST_F(
+    a_container_with_three_components,
+    forwards_events_to_a_subcomponent_that_announced_it_gained_focus)
+{
+    ON_CALL(*component2_, do_has_focus()).WillByDefault(Return(true));
+    component2_->on_focus_set();
+
+    EXPECT_CALL(*component0_, do_has_focus()).Times(0);
+    EXPECT_CALL(*component1_, do_has_focus()).Times(0);
+    EXPECT_CALL(*component2_, do_event(_));
+
+    container_.event('X');
+}
+
+TEST_F(
+    a_container_with_three_components,
+    forwards_events_to_a_focussed_subcomponent_after_another_is_removed)
+{
+    container_.remove_component(component0_);
+
+    ON_CALL(*component2_, do_has_focus()).WillByDefault(Return(true));
+    component2_->on_focus_set();
+
+    EXPECT_CALL(*component1_, do_has_focus()).Times(0);
+    EXPECT_CALL(*component2_, do_event(_));
+
+    container_.event('X');
+}
+
 TEST_F(
     a_container_with_one_component,
     forwards_mouse_events_even_though_the_component_has_no_focus)
@@ -163,3 +212,95 @@ TEST_F(
 
     container_.event(event);
 }
+
+TEST_F(
+    a_container_with_many_components,
+    forwards_mouse_events_to_the_component_at_the_mouse_report_location)
+{
+    static terminalpp::mouse::event const event = {
+        terminalpp::mouse::event_type::left_button_down, {37, 0}
+    };
+
+    static terminalpp::mouse::event const expected_value = {
+        terminalpp::mouse::event_type::left_button_down, {0, 0}
+    };
+
+    for (std::size_t index = 0; index < components_.size(); ++index)
+    {
+        if (index == 37)
+        {
+            EXPECT_CALL(*components_[index], do_event(_))
+                .WillOnce([](std::any ev) {
+                    auto *report = std::any_cast<terminalpp::mouse::event>(&ev);
+                    ASSERT_NE(nullptr, report);
+                    ASSERT_EQ(expected_value, *report);
+                });
+        }
+        else
+        {
+            EXPECT_CALL(*components_[index], do_event(_)).Times(0);
+        }
+    }
+
+    container_.event(event);
+}
+
+TEST_F(
+    a_container_with_many_components,
+    forwards_mouse_events_past_a_removed_component)
+{
+    static terminalpp::mouse::event const event = {
+        terminalpp::mouse::event_type::left_button_down, {37, 0}
+    };
+
+    // Removing a component moves those that follow it, and so the component
+    // at the location must be found at its new index.
+    container_.remove_component(components_[20]);
+
+    for (std::size_t index = 0; index < components_.size(); ++index)
+    {
+        EXPECT_CALL(*components_[index], do_event(_))
+            .Times(index == 37 ? 1 : 0);
+    }
+
+    container_.event(event);
+}
+
+TEST_F(
+    a_container_with_many_components,
+    forwards_mouse_events_to_a_component_that_has_moved)
+{
+    static terminalpp::mouse::event const event = {
+        terminalpp::mouse::event_type::left_button_down, {37, 0}
+    };
+
+    // Drawing the container builds its spatial index, after which the
+    // components are swapped over by being told to move, without the
+    // container being laid out.
+    terminalpp::canvas canvas({64, 1});
+    munin::render_surface surface{canvas};
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {64, 1}));
+
+    for (auto const index : {5, 37})
+    {
+        auto const position = std::make_shared<terminalpp::point>(index, 0);
+
+        ON_CALL(*components_[index], do_set_position(_))
+            .WillByDefault([position](terminalpp::point const &pos) {
+                *position = pos;
+            });
+        ON_CALL(*components_[index], do_get_position())
+            .WillByDefault([position] { return *position; });
+    }
+
+    components_[5]->set_position({37, 0});
+    components_[37]->set_position({5, 0});
+
+    for (std::size_t index = 0; index < components_.size(); ++index)
+    {
+        EXPECT_CALL(*components_[index], do_event(_))
+            .Times(index == 5 ? 1 : 0);
+    }
+
+    container_.event(event);
+}
@@ -1,8 +1,12 @@
 #include "container_test.hpp"
 #include "mock/layout.hpp"
 
+#include <munin/redraw_transaction.hpp>
+#include <munin/render_surface.hpp>
+
 using testing::_;
 using testing::InSequence;
+using testing::Invoke;
 using testing::Return;
 
 TEST(
@@ -76,6 +80,17 @@ TEST_F(a_container, lays_out_the_container_when_its_size_is_changed)
     container_.set_size({1, 1});
 }
 
+TEST_F(a_container, does_not_lay_out_again_when_set_to_its_current_size)
+{
+    auto layout = make_mock_layout();
+
+    EXPECT_CALL(*layout, do_layout(_, _, _)).Times(2);
+
+    container_.set_layout(std::move(layout));
+    container_.set_size({1, 1});
+    container_.set_size({1, 1});
+}
+
 TEST_F(a_container, has_the_preferred_size_of_its_layout)
 {
     auto layout = make_mock_layout();
@@ -96,3 +111,155 @@ TEST_F(a_container, has_the_preferred_size_of_its_layout)
 
     ASSERT_EQ(expected_result, container_.get_preferred_size());
 }
+
+TEST_F(a_container, lays_out_once_when_changed_within_a_redraw_transaction)
+{
+    auto layout = make_mock_layout();
+    auto const size = terminalpp::extent{80, 24};
+
+    EXPECT_CALL(*layout, do_layout(_, _, size)).Times(1);
+
+    {
+        munin::redraw_transaction const transaction;
+
+        container_.set_layout(std::move(layout));
+        container_.add_component(make_mock_component());
+        container_.add_component(make_mock_component());
+        container_.add_component(make_mock_component());
+        container_.set_size(size);
+    }
+}
+
+TEST_F(a_container, lays_out_before_drawing_within_a_redraw_transaction)
+{
+    auto layout = make_mock_layout();
+    bool laid_out = false;
+
+    EXPECT_CALL(*layout, do_layout(_, _, _))
+        .WillOnce(Invoke([&laid_out](auto const &, auto const &, auto) {
+            laid_out = true;
+        }));
+
+    munin::redraw_transaction const transaction;
+
+    container_.set_layout(std::move(layout));
+    container_.set_size({2, 2});
+    ASSERT_FALSE(laid_out);
+
+    terminalpp::canvas canvas({2, 2});
+    munin::render_surface surface{canvas};
+    container_.draw(surface, terminalpp::rectangle({0, 0}, {2, 2}));
+
+    ASSERT_TRUE(laid_out);
+}
+
+TEST_F(a_container, calculates_its_preferred_size_only_once_while_unchanged)
+{
+    auto layout = make_mock_layout();
+    auto const expected_result = terminalpp::extent{42, 69};
+
+    EXPECT_CALL(*layout, do_layout(_, _, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*layout, do_get_preferred_size(_, _))
+        .WillOnce(Return(expected_result));
+
+    container_.set_layout(std::move(layout));
+
+    ASSERT_EQ(expected_result, container_.get_preferred_size());
+    ASSERT_EQ(expected_result, container_.get_preferred_size());
+}
+
+TEST_F(
+    a_container,
+    recalculates_its_preferred_size_when_a_subcomponent_preferred_size_changes)
+{
+    auto layout = make_mock_layout();
+    auto component = make_mock_component();
+    auto const initial_result = terminalpp::extent{42, 69};
+    auto const changed_result = terminalpp::extent{17, 3};
+
+    EXPECT_CALL(*layout, do_layout(_, _, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*layout, do_get_preferred_size(_, _))
+        .WillOnce(Return(initial_result))
+        .WillOnce(Return(changed_result));
+
+    container_.add_component(component);
+    container_.set_layout(std::move(layout));
+    ASSERT_EQ(initial_result, container_.get_preferred_size());
+
+    reset_counters();
+    component->on_preferred_size_changed();
+
+    ASSERT_EQ(1, preferred_size_changed_count_);
+    ASSERT_EQ(changed_result, container_.get_preferred_size());
+}
+
+TEST_F(
+    a_container_with_three_components,
+    keeps_the_order_of_the_remaining_components_when_one_is_removed)
+{
+    auto layout = make_mock_layout();
+    auto *layout_ptr = layout.get();
+    container_.set_layout(std::move(layout));
+
+    using component_list = std::vector<std::shared_ptr<munin::component>>;
+    auto const expected = component_list{component0_, component2_};
+
+    EXPECT_CALL(*layout_ptr, do_layout(expected, _, _));
+    container_.remove_component(component1_);
+}
+
+TEST_F(
+    a_container_with_two_components,
+    lays_out_once_when_its_components_are_replaced)
+{
+    auto layout = make_mock_layout();
+    auto *layout_ptr = layout.get();
+    container_.set_layout(std::move(layout));
+    reset_counters();
+
+    auto const replacement0 = make_mock_component();
+    auto const replacement1 = make_mock_component();
+
+    using component_list = std::vector<std::shared_ptr<munin::component>>;
+    auto const expected = component_list{replacement0, replacement1};
+
+    EXPECT_CALL(*layout_ptr, do_layout(expected, _, _));
+    container_.replace_components({replacement0, replacement1});
+    ASSERT_EQ(1, preferred_size_changed_count_);
+}
+
+TEST_F(
+    a_container_with_three_components,
+    lays_out_once_per_removal_outside_a_redraw_transaction)
+{
+    auto layout = make_mock_layout();
+    auto *layout_ptr = layout.get();
+    container_.set_layout(std::move(layout));
+
+    EXPECT_CALL(*layout_ptr, do_layout(_, _, _)).Times(3);
+
+    container_.remove_component(component0_);
+    container_.remove_component(component1_);
+    container_.remove_component(component2_);
+}
+
+TEST_F(
+    a_container_with_three_components,
+    lays_out_once_for_several_removals_within_a_redraw_transaction)
+{
+    auto layout = make_mock_layout();
+    auto *layout_ptr = layout.get();
+    container_.set_layout(std::move(layout));
+
+    using component_list = std::vector<std::shared_ptr<munin::component>>;
+    auto const expected = component_list{component1_};
+
+    EXPECT_CALL(*layout_ptr, do_layout(expected, _, _)).Times(1);
+
+    {
+        munin::redraw_transaction const transaction;
+
+        container_.remove_component(component0_);
+        container_.remove_component(component2_);
+    }
+}
@@ -1,6 +1,9 @@
 #include "container_test.hpp"
 #include "redraw.hpp"
 
+#include <munin/filled_box.hpp>
+#include <munin/redraw_transaction.hpp>
+
 using testing::Return;
 
 TEST_F(
@@ -43,3 +46,83 @@ TEST_F(
 
     ASSERT_EQ(0, redraw_count_);
 }
+
+TEST_F(
+    a_container_with_one_component,
+    merges_subcomponent_redraws_made_during_a_redraw_transaction)
+{
+    EXPECT_CALL(*component_, do_get_position())
+        .WillRepeatedly(Return(terminalpp::point(1, 1)));
+
+    std::vector<terminalpp::rectangle> redrawn_regions;
+    container_.on_redraw.connect(
+        [&](auto const &regions) { redrawn_regions = regions; });
+
+    {
+        munin::redraw_transaction const transaction;
+
+        component_->on_redraw({
+            {{0, 0}, {2, 1}}
+        });
+        component_->on_redraw({
+            {{0, 0}, {2, 1}},
+            {{0, 1}, {2, 1}}
+        });
+
+        ASSERT_EQ(0, redraw_count_);
+    }
+
+    ASSERT_EQ(1, redraw_count_);
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{1, 1}, {2, 2}}
+    };
+    ASSERT_EQ(expected, redrawn_regions);
+}
+
+TEST_F(
+    a_container_with_one_component,
+    does_not_redraw_after_a_transaction_if_destroyed_during_it)
+{
+    auto container = std::make_unique<munin::container>();
+    container->add_component(component_);
+
+    {
+        munin::redraw_transaction const transaction;
+
+        component_->on_redraw({
+            {{0, 0}, {1, 1}}
+        });
+
+        container.reset();
+    }
+
+    SUCCEED();
+}
+
+TEST_F(
+    a_new_container,
+    keeps_a_subcomponent_alive_while_it_is_removed_from_its_own_redraw)
+{
+    // The container is the only owner of the subcomponent, so removing it
+    // from within the redraw that it announced would destroy it while the
+    // container was still handling that redraw.
+    auto subcomponent = munin::make_fill('x');
+    auto *const raw_subcomponent = subcomponent.get();
+    std::weak_ptr<munin::component> const weak_subcomponent = subcomponent;
+
+    container_.add_component(std::move(subcomponent));
+
+    bool expired_during_redraw = true;
+    container_.on_redraw.connect([&](auto const &) {
+        container_.remove_component(weak_subcomponent.lock());
+        expired_during_redraw = weak_subcomponent.expired();
+    });
+
+    raw_subcomponent->on_redraw({
+        {{0, 0}, {1, 1}}
+    });
+
+    ASSERT_FALSE(expired_during_redraw);
+    ASSERT_TRUE(weak_subcomponent.expired());
+}
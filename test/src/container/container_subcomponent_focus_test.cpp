@@ -1,5 +1,8 @@
 #include "container_test.hpp"
 
+#include <terminalpp/virtual_key.hpp>
+
+using testing::_;
 using testing::Return;
 
 TEST_F(a_container_with_one_component, sets_focus_when_component_sets_focus)
@@ -75,3 +78,42 @@ TEST_F(
     ASSERT_EQ(0, focus_set_count_);
     ASSERT_EQ(0, focus_lost_count_);
 }
+
+TEST_F(
+    a_container_with_three_components_where_the_last_has_focus,
+    removes_focus_from_the_last_component_when_an_earlier_component_sets_focus_after_a_removal)
+{
+    // Removing a component means that the container no longer remembers
+    // which component has focus, so it must search for it, and must not
+    // find the component that has just taken focus instead.
+    container_.remove_component(component0_);
+
+    ON_CALL(*component1_, do_has_focus()).WillByDefault(Return(true));
+    EXPECT_CALL(*component2_, do_lose_focus())
+        .WillOnce(std::ref(component2_->on_focus_lost));
+
+    component1_->on_focus_set();
+
+    ASSERT_TRUE(container_.has_focus());
+    ASSERT_EQ(0, focus_lost_count_);
+}
+
+TEST_F(
+    a_container_with_two_components,
+    does_not_pass_focus_to_a_sibling_of_a_component_removed_as_it_takes_focus)
+{
+    // Removing the component from within the container's announcement that
+    // it has gained focus moves its sibling into its place, so the index of
+    // the component that took focus must not be remembered afterwards.
+    container_.on_focus_set.connect([this] {
+        container_.remove_component(component0_);
+        static_cast<void>(container_.get_preferred_size());
+    });
+
+    component0_->on_focus_set();
+
+    EXPECT_CALL(*component1_, do_has_focus()).WillRepeatedly(Return(false));
+    EXPECT_CALL(*component1_, do_event(_)).Times(0);
+
+    container_.event(terminalpp::virtual_key{terminalpp::vk::enter});
+}
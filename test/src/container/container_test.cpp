@@ -86,3 +86,66 @@ TEST_F(
     container_.remove_component(component_);
     ASSERT_EQ(1, preferred_size_changed_count_);
 }
+
+TEST_F(
+    a_container_with_one_component,
+    does_not_report_a_preferred_size_change_when_removing_another_component)
+{
+    container_.remove_component(make_mock_component());
+    ASSERT_EQ(0, preferred_size_changed_count_);
+}
+
+TEST_F(
+    a_container_with_three_components,
+    disconnects_from_a_component_removed_after_another)
+{
+    container_.remove_component(component2_);
+    container_.remove_component(component0_);
+    reset_counters();
+
+    component0_->on_preferred_size_changed();
+    ASSERT_EQ(0, preferred_size_changed_count_);
+
+    component1_->on_preferred_size_changed();
+    ASSERT_EQ(1, preferred_size_changed_count_);
+}
+
+TEST_F(a_container_with_two_components, can_have_its_components_replaced)
+{
+    reset_counters();
+    auto const replacement = make_mock_component();
+
+    container_.replace_components({replacement});
+    ASSERT_EQ(1, preferred_size_changed_count_);
+    ASSERT_EQ(1, container_.to_json()["subcomponents"].size());
+
+    // The replaced components are no longer connected to the container.
+    component0_->on_preferred_size_changed();
+    ASSERT_EQ(1, preferred_size_changed_count_);
+
+    replacement->on_preferred_size_changed();
+    ASSERT_EQ(2, preferred_size_changed_count_);
+}
+
+TEST_F(
+    a_container_with_two_components,
+    keeps_the_connections_of_a_component_that_remains_after_a_removal)
+{
+    container_.remove_component(component1_);
+    reset_counters();
+
+    component0_->on_redraw({
+        {{0, 0}, {1, 1}}
+    });
+    ASSERT_EQ(1, redraw_count_);
+
+    // The remaining component's connections must also still be held by
+    // the container, so that they are broken when it is removed in turn.
+    container_.remove_component(component0_);
+    reset_counters();
+
+    component0_->on_redraw({
+        {{0, 0}, {1, 1}}
+    });
+    ASSERT_EQ(0, redraw_count_);
+}
@@ -247,3 +247,31 @@ protected:
         assert(this->container_.has_focus());
     }
 };
+
+class a_container_with_many_components : public a_container
+{
+protected:
+    a_container_with_many_components()
+    {
+        using testing::Return;
+
+        // A single row of 1x1 components, enough that the container uses a
+        // spatial index for drawing and hit-testing.
+        for (terminalpp::coordinate_type index = 0; index < 64; ++index)
+        {
+            auto comp = make_mock_component();
+            ON_CALL(*comp, do_get_position())
+                .WillByDefault(Return(terminalpp::point(index, 0)));
+            ON_CALL(*comp, do_get_size())
+                .WillByDefault(Return(terminalpp::extent(1, 1)));
+
+            container_.add_component(comp);
+            components_.push_back(comp);
+        }
+
+        container_.set_size({64, 1});
+        reset_counters();
+    }
+
+    std::vector<std::shared_ptr<mock_component>> components_;
+};
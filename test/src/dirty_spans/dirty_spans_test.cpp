@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include <munin/dirty_spans.hpp>
+
+TEST(a_new_dirty_spans, is_empty)
+{
+    munin::dirty_spans dirty;
+    dirty.reset({4, 4});
+
+    ASSERT_TRUE(dirty.empty());
+    ASSERT_TRUE(dirty.rectangles().empty());
+}
+
+TEST(dirty_spans, records_the_extent_of_changes_in_each_row)
+{
+    munin::dirty_spans dirty;
+    dirty.reset({10, 3});
+
+    dirty.mark(0, 2, 3);
+    dirty.mark(0, 6, 8);
+    dirty.mark(2, 1, 2);
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{2, 0}, {6, 1}},
+        {{1, 2}, {1, 1}},
+    };
+
+    ASSERT_FALSE(dirty.empty());
+    ASSERT_EQ(expected, dirty.rectangles());
+}
+
+TEST(dirty_spans, ignores_changes_outside_of_the_canvas)
+{
+    munin::dirty_spans dirty;
+    dirty.reset({4, 2});
+
+    dirty.mark(-1, 0, 4);
+    dirty.mark(2, 0, 4);
+    dirty.mark(0, 4, 6);
+    dirty.mark(1, -2, 1);
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{0, 1}, {1, 1}},
+    };
+
+    ASSERT_EQ(expected, dirty.rectangles());
+}
+
+TEST(dirty_spans, is_cleared_by_reset)
+{
+    munin::dirty_spans dirty;
+    dirty.reset({4, 2});
+    dirty.mark(0, 0, 4);
+    dirty.reset({4, 2});
+
+    ASSERT_TRUE(dirty.empty());
+}
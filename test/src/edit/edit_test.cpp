@@ -75,6 +75,31 @@ TEST_F(a_new_edit, draws_blanks)
         cvs);
 }
 
+TEST_F(a_new_edit, draws_nothing_in_a_region_beyond_its_width)
+{
+    terminalpp::canvas cvs{
+        {4, 3}
+    };
+    fill_canvas(cvs, 'x');
+
+    edit_->set_position({1, 1});
+    edit_->set_size({2, 1});
+
+    munin::render_surface surface{cvs};
+    surface.offset_by({1, 1});
+    edit_->draw(surface, {{3, 0}, {2, 1}});
+
+    assert_similar_canvas_block(
+        {
+            // clang-format off
+          "xxxx"_ts,
+          "xxxx"_ts,
+          "xxxx"_ts,
+            // clang-format on
+        },
+        cvs);
+}
+
 TEST_F(a_new_edit, inserting_text_changes_preferred_size_to_size_of_text)
 {
     terminalpp::extent preferred_size;
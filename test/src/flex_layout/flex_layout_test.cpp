@@ -0,0 +1,210 @@
+#include "mock/component.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <munin/filled_box.hpp>
+#include <munin/flex_layout.hpp>
+#include <munin/image.hpp>
+#include <munin/view.hpp>
+
+#include <any>
+#include <memory>
+#include <vector>
+
+using testing::Return;
+using testing::StrictMock;
+
+namespace {
+
+std::shared_ptr<munin::component> make_flex_component(
+    terminalpp::extent preferred_size, terminalpp::rectangle expected_placement)
+{
+    auto comp = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp);
+    EXPECT_CALL(*comp, do_get_preferred_size())
+        .WillRepeatedly(Return(preferred_size));
+    EXPECT_CALL(*comp, do_set_position(expected_placement.origin_));
+    EXPECT_CALL(*comp, do_set_size(expected_placement.size_));
+
+    return comp;
+}
+
+}  // namespace
+
+TEST(make_flex_layout, creates_a_new_flex_layout)
+{
+    auto lyt = munin::make_flex_layout();
+    auto fl = dynamic_cast<munin::flex_layout *>(lyt.get());
+    ASSERT_TRUE(fl != nullptr);
+}
+
+TEST(a_flex_layout, reports_attributes_as_json)
+{
+    munin::flex_layout const fl{munin::flex_layout::direction::column};
+    munin::layout const &lyt = fl;
+
+    nlohmann::json json = lyt.to_json();
+
+    ASSERT_EQ("flex_layout", json["type"]);
+    ASSERT_EQ("column", json["direction"]);
+}
+
+TEST(a_flex_layout_with_no_components, has_a_preferred_size_of_zero)
+{
+    munin::flex_layout const fl;
+    ASSERT_EQ(terminalpp::extent{}, fl.get_preferred_size({}, {}));
+}
+
+TEST(
+    a_flex_layout,
+    has_a_preferred_size_of_the_sum_of_the_bases_by_the_largest_cross_size)
+{
+    auto comp0 = std::make_shared<StrictMock<mock_component>>();
+    EXPECT_CALL(*comp0, do_get_preferred_size())
+        .WillRepeatedly(Return(terminalpp::extent{4, 2}));
+
+    auto comp1 = std::make_shared<StrictMock<mock_component>>();
+    EXPECT_CALL(*comp1, do_get_preferred_size())
+        .WillRepeatedly(Return(terminalpp::extent{7, 5}));
+
+    munin::flex_layout const row{munin::flex_layout::direction::row};
+    munin::flex_layout const column{munin::flex_layout::direction::column};
+
+    auto const hints = std::vector<std::any>{
+        munin::flex_layout::hint{}, munin::flex_layout::hint{.basis = 10}};
+
+    auto const expected_row_size = terminalpp::extent{14, 5};
+    ASSERT_EQ(expected_row_size, row.get_preferred_size({comp0, comp1}, hints));
+
+    auto const expected_column_size = terminalpp::extent{7, 12};
+    ASSERT_EQ(
+        expected_column_size, column.get_preferred_size({comp0, comp1}, hints));
+}
+
+TEST(a_flex_layout, lays_out_components_without_hints_at_their_preferred_size)
+{
+    auto comp0 = make_flex_component({3, 1}, {{0, 0}, {3, 6}});
+    auto comp1 = make_flex_component({4, 9}, {{3, 0}, {4, 6}});
+
+    munin::flex_layout const fl;
+    fl({comp0, comp1}, {}, {10, 6});
+}
+
+TEST(a_flex_layout, shares_remaining_space_in_proportion_to_grow_factors)
+{
+    // There are 11 spare columns, shared 1:2 between the last two
+    // components, which do not divide evenly.
+    auto comp0 = make_flex_component({2, 1}, {{0, 0}, {2, 1}});
+    auto comp1 = make_flex_component({2, 1}, {{2, 0}, {5, 1}});
+    auto comp2 = make_flex_component({2, 1}, {{7, 0}, {10, 1}});
+
+    munin::flex_layout const fl;
+    fl({comp0, comp1, comp2},
+       {munin::flex_layout::hint{},
+        munin::flex_layout::hint{.grow = 1},
+        munin::flex_layout::hint{.grow = 2}},
+       {17, 1});
+}
+
+TEST(a_flex_layout, shrinks_components_in_proportion_to_their_bases)
+{
+    // There is a shortfall of 15 columns, which is taken 1:2 from the
+    // components, and nothing from the one that does not shrink.
+    auto comp0 = make_flex_component({10, 1}, {{0, 0}, {5, 1}});
+    auto comp1 = make_flex_component({20, 1}, {{5, 0}, {10, 1}});
+    auto comp2 = make_flex_component({5, 1}, {{15, 0}, {5, 1}});
+
+    munin::flex_layout const fl;
+    fl({comp0, comp1, comp2},
+       {munin::flex_layout::hint{},
+        munin::flex_layout::hint{},
+        munin::flex_layout::hint{.shrink = 0}},
+       {20, 1});
+}
+
+TEST(a_flex_layout, shares_the_shortfall_of_components_shrunk_to_nothing)
+{
+    // There is a shortfall of 15 columns, of which the first component's
+    // share would be more than its basis.  It is shrunk to nothing, and
+    // the remaining 5 columns are taken from the second component, so that
+    // both still fit within the width.
+    auto comp0 = make_flex_component({10, 1}, {{0, 0}, {0, 1}});
+    auto comp1 = make_flex_component({10, 1}, {{0, 0}, {5, 1}});
+
+    munin::flex_layout const fl;
+    fl({comp0, comp1},
+       {munin::flex_layout::hint{.shrink = 10},
+        munin::flex_layout::hint{.shrink = 1}},
+       {5, 1});
+}
+
+TEST(a_flex_layout, shrinks_many_components_to_nothing)
+{
+    // The first component does not shrink and fills the width by itself,
+    // so each of the others, which have ever larger shrink factors, must
+    // be shrunk to nothing.
+    std::vector<std::shared_ptr<munin::component>> components{
+        make_flex_component({10, 1}, {{0, 0}, {10, 1}})};
+    std::vector<std::any> hints{munin::flex_layout::hint{.shrink = 0}};
+
+    for (int shrink = 1; shrink <= 64; ++shrink)
+    {
+        components.push_back(make_flex_component({1, 1}, {{10, 0}, {0, 1}}));
+        hints.emplace_back(munin::flex_layout::hint{.shrink = shrink});
+    }
+
+    munin::flex_layout const fl;
+    fl(components, hints, {10, 1});
+}
+
+TEST(a_flex_layout, lays_out_columns_from_top_to_bottom_at_full_width)
+{
+    auto comp0 = make_flex_component({3, 1}, {{0, 0}, {8, 1}});
+    auto comp1 = make_flex_component({5, 1}, {{0, 1}, {8, 3}});
+    auto comp2 = make_flex_component({6, 1}, {{0, 4}, {8, 2}});
+
+    munin::flex_layout const fl{munin::flex_layout::direction::column};
+    fl({comp0, comp1, comp2},
+       {munin::flex_layout::hint{},
+        munin::flex_layout::hint{.grow = 1, .basis = 0},
+        munin::flex_layout::hint{.basis = 2}},
+       {8, 6});
+}
+
+TEST(a_flex_layout, arranges_a_screen_in_a_single_view)
+{
+    auto const header = munin::make_image("Header");
+    auto const sidebar = munin::make_fill('|');
+    auto const body = munin::make_fill(' ');
+    auto const footer = munin::make_image("Footer");
+
+    // A header and footer above and below a sidebar and a body, which
+    // would otherwise be a compass layout within a compass layout.
+    auto const screen = munin::view(
+        munin::make_flex_layout(munin::flex_layout::direction::column),
+        header,
+        munin::flex_layout::hint{},
+        munin::view(
+            munin::make_flex_layout(),
+            sidebar,
+            munin::flex_layout::hint{.basis = 10},
+            body,
+            munin::flex_layout::hint{.grow = 1}),
+        munin::flex_layout::hint{.grow = 1},
+        footer,
+        munin::flex_layout::hint{});
+
+    screen->set_size({80, 24});
+
+    ASSERT_EQ((terminalpp::rectangle{{0, 0}, {80, 1}}),
+              (terminalpp::rectangle{header->get_position(),
+                                     header->get_size()}));
+    ASSERT_EQ((terminalpp::rectangle{{0, 0}, {10, 22}}),
+              (terminalpp::rectangle{sidebar->get_position(),
+                                     sidebar->get_size()}));
+    ASSERT_EQ((terminalpp::rectangle{{10, 0}, {70, 22}}),
+              (terminalpp::rectangle{body->get_position(), body->get_size()}));
+    ASSERT_EQ((terminalpp::rectangle{{0, 23}, {80, 1}}),
+              (terminalpp::rectangle{footer->get_position(),
+                                     footer->get_size()}));
+}
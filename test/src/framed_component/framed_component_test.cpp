@@ -19,10 +19,12 @@ TEST(a_new_framed_component, is_constructed_from_a_frame_and_a_component)
 
 TEST(a_zero_size_framed_component, positions_subcomponents_at_origin)
 {
+    // A framed component starts out with zero size, and so it is laid out
+    // as such when it is constructed.
     auto mock_frame = make_mock_frame();
     auto mock_comp = make_mock_component();
-
-    auto framed_component = munin::make_framed_component(mock_frame, mock_comp);
+    unplace(*mock_frame);
+    unplace(*mock_comp);
 
     EXPECT_CALL(*mock_frame, north_border_height())
         .WillOnce(Return(terminalpp::coordinate_type{0}));
@@ -38,8 +40,7 @@ TEST(a_zero_size_framed_component, positions_subcomponents_at_origin)
     EXPECT_CALL(*mock_comp, do_set_position(terminalpp::point{0, 0}));
     EXPECT_CALL(*mock_comp, do_set_size(terminalpp::extent{0, 0}));
 
-    framed_component->set_position({0, 0});
-    framed_component->set_size({0, 0});
+    auto framed_component = munin::make_framed_component(mock_frame, mock_comp);
 }
 
 TEST(a_zero_width_framed_component, positions_inner_component_in_an_inner_row)
@@ -51,6 +52,8 @@ TEST(a_zero_width_framed_component, positions_inner_component_in_an_inner_row)
     std::shared_ptr<mock_component> mock_comp = make_mock_component();
 
     auto framed_component = munin::make_framed_component(mock_frame, mock_comp);
+    unplace(*mock_frame);
+    unplace(*mock_comp);
 
     EXPECT_CALL(*mock_frame, north_border_height())
         .WillOnce(Return(terminalpp::coordinate_type{1}));
@@ -81,6 +84,8 @@ TEST(
     std::shared_ptr<mock_component> mock_comp = make_mock_component();
 
     auto framed_component = munin::make_framed_component(mock_frame, mock_comp);
+    unplace(*mock_frame);
+    unplace(*mock_comp);
 
     EXPECT_CALL(*mock_frame, north_border_height())
         .WillOnce(Return(terminalpp::coordinate_type{1}));
@@ -108,6 +113,8 @@ TEST(
     std::shared_ptr<mock_component> mock_comp = make_mock_component();
 
     auto framed_component = munin::make_framed_component(mock_frame, mock_comp);
+    unplace(*mock_frame);
+    unplace(*mock_comp);
 
     EXPECT_CALL(*mock_frame, north_border_height())
         .WillOnce(Return(terminalpp::coordinate_type{1}));
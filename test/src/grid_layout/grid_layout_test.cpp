@@ -35,6 +35,7 @@ TEST(
     auto const expected = terminalpp::extent{5, 5};
 
     auto component = std::make_shared<mock_component>();
+    unplace(*component);
     EXPECT_CALL(*component, do_get_preferred_size())
         .WillRepeatedly(Return(expected));
 
@@ -143,6 +144,7 @@ TEST(
     auto const size = terminalpp::extent{4, 5};
 
     auto component = std::make_shared<mock_component>();
+    unplace(*component);
 
     EXPECT_CALL(*component, do_set_position(terminalpp::point(0, 0)));
     EXPECT_CALL(*component, do_set_size(terminalpp::extent(4, 5)));
@@ -176,6 +178,7 @@ TEST_P(laying_out_grids, at_these_positions)
     for (auto const &expected_result : expected_results)
     {
         auto component = std::make_shared<mock_component>();
+        unplace(*component);
         EXPECT_CALL(*component, do_set_position(std::get<0>(expected_result)));
         EXPECT_CALL(*component, do_set_size(std::get<1>(expected_result)));
 
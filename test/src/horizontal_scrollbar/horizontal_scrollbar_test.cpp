@@ -79,6 +79,23 @@ TEST_F(a_horizontal_scrollbar, has_a_preferred_size_relative_to_its_width)
     ASSERT_EQ(terminalpp::extent(7, 1), scrollbar_->get_preferred_size());
 }
 
+TEST_F(
+    a_horizontal_scrollbar,
+    announces_a_change_in_preferred_size_when_its_width_changes)
+{
+    scrollbar_->set_size({4, 4});
+
+    int preferred_size_changed = 0;
+    scrollbar_->on_preferred_size_changed.connect(
+        [&preferred_size_changed] { ++preferred_size_changed; });
+
+    scrollbar_->set_size({4, 3});
+    ASSERT_EQ(0, preferred_size_changed);
+
+    scrollbar_->set_size({7, 7});
+    ASSERT_EQ(1, preferred_size_changed);
+}
+
 TEST_F(a_horizontal_scrollbar, with_size_but_no_slider_draws_a_frame_border)
 {
     terminalpp::canvas canvas({4, 4});
@@ -0,0 +1,6 @@
+#include "mock/repaint_scheduler.hpp"
+
+std::shared_ptr<mock_repaint_scheduler> make_mock_repaint_scheduler()
+{
+    return std::make_shared<testing::NiceMock<mock_repaint_scheduler>>();
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <munin/redraw_transaction.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+TEST(no_redraw_transaction, is_open_by_default)
+{
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+}
+
+TEST(a_redraw_transaction, is_open_while_in_scope)
+{
+    {
+        munin::redraw_transaction const transaction;
+        ASSERT_TRUE(munin::redraw_transaction::is_open());
+    }
+
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+}
+
+TEST(a_redraw_transaction, runs_deferred_functions_when_closed)
+{
+    std::vector<int> calls;
+
+    {
+        munin::redraw_transaction const transaction;
+        munin::redraw_transaction::defer([&] { calls.push_back(0); });
+        munin::redraw_transaction::defer([&] { calls.push_back(1); });
+
+        ASSERT_TRUE(calls.empty());
+    }
+
+    ASSERT_EQ((std::vector<int>{0, 1}), calls);
+}
+
+TEST(
+    a_redraw_transaction_closed_by_an_exception,
+    keeps_deferred_functions_for_the_next_transaction)
+{
+    int calls = 0;
+
+    try
+    {
+        munin::redraw_transaction const transaction;
+        munin::redraw_transaction::defer([&] { ++calls; });
+        throw std::runtime_error("error");
+    }
+    catch (std::runtime_error const &)
+    {
+    }
+
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+    ASSERT_EQ(0, calls);
+
+    {
+        munin::redraw_transaction const transaction;
+    }
+
+    ASSERT_EQ(1, calls);
+}
+
+TEST(a_nested_redraw_transaction, defers_until_the_outermost_is_closed)
+{
+    int calls = 0;
+
+    {
+        munin::redraw_transaction const outer;
+
+        {
+            munin::redraw_transaction const inner;
+            munin::redraw_transaction::defer([&] { ++calls; });
+        }
+
+        ASSERT_EQ(0, calls);
+    }
+
+    ASSERT_EQ(1, calls);
+}
+
+TEST(a_redraw_transaction, runs_functions_deferred_by_deferred_functions)
+{
+    std::vector<int> calls;
+
+    {
+        munin::redraw_transaction const transaction;
+        munin::redraw_transaction::defer([&] {
+            calls.push_back(0);
+            munin::redraw_transaction::defer([&] { calls.push_back(1); });
+        });
+    }
+
+    ASSERT_EQ((std::vector<int>{0, 1}), calls);
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+}
+
+TEST(a_redraw_transaction, runs_deferred_layouts_first_most_recent_first)
+{
+    std::vector<int> calls;
+
+    {
+        munin::redraw_transaction const transaction;
+        munin::redraw_transaction::defer([&] { calls.push_back(2); });
+        munin::redraw_transaction::defer_layout([&] { calls.push_back(1); });
+        munin::redraw_transaction::defer_layout([&] { calls.push_back(0); });
+    }
+
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), calls);
+}
+
+TEST(
+    a_redraw_transaction_with_a_throwing_deferred_function,
+    passes_the_exception_on_and_keeps_the_rest_for_the_next_transaction)
+{
+    int calls = 0;
+
+    auto const close_transaction = [&] {
+        munin::redraw_transaction const transaction;
+        munin::redraw_transaction::defer(
+            [] { throw std::runtime_error("error"); });
+        munin::redraw_transaction::defer([&] { ++calls; });
+    };
+
+    ASSERT_THROW(close_transaction(), std::runtime_error);
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+    ASSERT_EQ(0, calls);
+
+    {
+        munin::redraw_transaction const transaction;
+    }
+
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(munin::redraw_transaction::is_open());
+}
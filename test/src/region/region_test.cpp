@@ -0,0 +1,186 @@
+#include "redraw.hpp"
+
+#include <gtest/gtest.h>
+#include <munin/region.hpp>
+
+#include <numeric>
+
+TEST(a_new_region, is_empty)
+{
+    munin::region rgn;
+
+    ASSERT_TRUE(rgn.empty());
+    ASSERT_TRUE(rgn.rectangles().empty());
+    ASSERT_EQ(terminalpp::rectangle{}, rgn.bounds());
+}
+
+TEST(a_region_constructed_from_an_empty_rectangle, is_empty)
+{
+    munin::region rgn{
+        terminalpp::rectangle{{1, 1}, {0, 5}}
+    };
+
+    ASSERT_TRUE(rgn.empty());
+}
+
+TEST(a_region_constructed_from_a_rectangle, contains_only_that_rectangle)
+{
+    auto const rect = terminalpp::rectangle{
+        {1, 2},
+        {3, 4}
+    };
+    munin::region rgn{rect};
+
+    ASSERT_FALSE(rgn.empty());
+    ASSERT_EQ(std::vector<terminalpp::rectangle>{rect}, rgn.rectangles());
+    ASSERT_EQ(rect, rgn.bounds());
+    ASSERT_EQ(12, rgn.area());
+    ASSERT_TRUE(rgn.contains({1, 2}));
+    ASSERT_TRUE(rgn.contains({3, 5}));
+    ASSERT_FALSE(rgn.contains({4, 5}));
+    ASSERT_FALSE(rgn.contains({3, 6}));
+    ASSERT_FALSE(rgn.contains({0, 2}));
+}
+
+TEST(a_region, merges_duplicate_rectangles)
+{
+    auto const rect = terminalpp::rectangle{
+        {0,  0},
+        {10, 1}
+    };
+
+    munin::region rgn{
+        std::vector<terminalpp::rectangle>{rect, rect, rect}
+    };
+
+    ASSERT_EQ(std::vector<terminalpp::rectangle>{rect}, rgn.rectangles());
+}
+
+TEST(a_region, merges_vertically_adjacent_rectangles_of_the_same_width)
+{
+    munin::region rgn{
+        std::vector<terminalpp::rectangle>{
+                                           {{0, 0}, {10, 1}},
+                                           {{0, 1}, {10, 1}},
+                                           }
+    };
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{0, 0}, {10, 2}}
+    };
+
+    ASSERT_EQ(expected, rgn.rectangles());
+}
+
+TEST(a_region, covers_overlapping_rectangles_without_overlap)
+{
+    auto const rects = std::vector<terminalpp::rectangle>{
+        {{0, 0}, {4, 4}},
+        {{2, 2}, {4, 4}},
+        {{1, 1}, {2, 2}},
+    };
+
+    munin::region rgn{rects};
+    auto const result = rgn.rectangles();
+
+    assert_equivalent_redraw_regions(rects, result);
+
+    // 16 + 16 - 4 (the overlap of the first two) cells.
+    ASSERT_EQ(28, rgn.area());
+
+    auto const total_area = std::accumulate(
+        result.begin(), result.end(), 0, [](auto total, auto const &rect) {
+            return total + rect.size_.width_ * rect.size_.height_;
+        });
+
+    ASSERT_EQ(28, total_area);
+}
+
+TEST(a_region, can_be_intersected_with_another_region)
+{
+    munin::region const lhs{
+        terminalpp::rectangle{{0, 0}, {4, 4}}
+    };
+    munin::region const rhs{
+        terminalpp::rectangle{{2, 1}, {4, 4}}
+    };
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{2, 1}, {2, 3}}
+    };
+
+    ASSERT_EQ(expected, (lhs & rhs).rectangles());
+}
+
+TEST(a_region, is_empty_when_intersected_with_a_disjoint_region)
+{
+    munin::region const lhs{
+        terminalpp::rectangle{{0, 0}, {4, 4}}
+    };
+    munin::region const rhs{
+        terminalpp::rectangle{{4, 0}, {4, 4}}
+    };
+
+    ASSERT_TRUE((lhs & rhs).empty());
+}
+
+TEST(a_region, can_have_another_region_subtracted_from_it)
+{
+    munin::region const lhs{
+        terminalpp::rectangle{{0, 0}, {3, 3}}
+    };
+    munin::region const rhs{
+        terminalpp::rectangle{{1, 1}, {1, 1}}
+    };
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{0, 0}, {3, 1}},
+        {{0, 1}, {1, 1}},
+        {{2, 1}, {1, 1}},
+        {{0, 2}, {3, 1}},
+    };
+
+    auto const result = lhs - rhs;
+
+    ASSERT_EQ(expected, result.rectangles());
+    ASSERT_EQ(8, result.area());
+    ASSERT_FALSE(result.contains({1, 1}));
+}
+
+TEST(a_region, is_restored_by_adding_back_a_subtracted_region)
+{
+    munin::region const whole{
+        terminalpp::rectangle{{0, 0}, {3, 3}}
+    };
+    munin::region const hole{
+        terminalpp::rectangle{{1, 1}, {1, 1}}
+    };
+
+    ASSERT_EQ(whole, (whole - hole) | hole);
+}
+
+TEST(a_region, can_be_translated)
+{
+    munin::region rgn{
+        terminalpp::rectangle{{1, 1}, {2, 2}}
+    };
+
+    rgn.translate({3, -1});
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{4, 0}, {2, 2}}
+    };
+
+    ASSERT_EQ(expected, rgn.rectangles());
+}
+
+TEST(a_region, can_be_cleared)
+{
+    munin::region rgn{
+        terminalpp::rectangle{{1, 1}, {2, 2}}
+    };
+
+    rgn.clear();
+
+    ASSERT_TRUE(rgn.empty());
+}
@@ -61,3 +61,288 @@ TEST(render_surface_test, offset_is_cumulative)
     render_surface[0][0] = 'x';
     ASSERT_TRUE(canvas[2][2] == 'x');
 }
+
+TEST(render_surface_test, row_span_views_a_run_of_elements_in_a_row)
+{
+    terminalpp::canvas canvas({4, 2});
+    munin::render_surface render_surface(canvas);
+
+    auto const row = render_surface.row_span({1, 1}, 2);
+    ASSERT_EQ(2U, row.size());
+
+    row[0] = 'a';
+    row[1] = 'b';
+
+    ASSERT_TRUE(canvas[0][1] == ' ');
+    ASSERT_TRUE(canvas[1][1] == 'a');
+    ASSERT_TRUE(canvas[2][1] == 'b');
+    ASSERT_TRUE(canvas[3][1] == ' ');
+}
+
+TEST(render_surface_test, row_span_is_truncated_at_the_edge_of_the_surface)
+{
+    terminalpp::canvas canvas({4, 2});
+    munin::render_surface render_surface(canvas);
+
+    ASSERT_EQ(1U, render_surface.row_span({3, 0}, 5).size());
+    ASSERT_TRUE(render_surface.row_span({4, 0}, 5).empty());
+    ASSERT_TRUE(render_surface.row_span({0, 2}, 5).empty());
+    ASSERT_TRUE(render_surface.row_span({-1, 0}, 5).empty());
+}
+
+TEST(render_surface_test, row_span_respects_the_offset)
+{
+    terminalpp::canvas canvas({3, 3});
+    munin::render_surface render_surface(canvas);
+
+    render_surface.offset_by({1, 1});
+
+    auto const row = render_surface.row_span({0, 1}, 3);
+    ASSERT_EQ(2U, row.size());
+
+    row[0] = 'x';
+
+    ASSERT_TRUE(canvas[1][2] == 'x');
+}
+
+TEST(render_surface_test, write_row_discards_elements_outside_the_surface)
+{
+    terminalpp::canvas canvas({3, 1});
+    munin::render_surface render_surface(canvas);
+
+    terminalpp::element const elements[] = {'a', 'b', 'c', 'd', 'e'};
+
+    render_surface.write_row({-1, 0}, elements);
+
+    ASSERT_TRUE(canvas[0][0] == 'b');
+    ASSERT_TRUE(canvas[1][0] == 'c');
+    ASSERT_TRUE(canvas[2][0] == 'd');
+
+    render_surface.write_row({2, 0}, elements);
+
+    ASSERT_TRUE(canvas[1][0] == 'c');
+    ASSERT_TRUE(canvas[2][0] == 'a');
+}
+
+TEST(render_surface_test, fill_sets_every_element_in_a_region)
+{
+    terminalpp::canvas canvas({3, 3});
+    munin::render_surface render_surface(canvas);
+
+    render_surface.offset_by({1, 0});
+    render_surface.fill({{-1, 1}, {5, 1}}, 'x');
+
+    ASSERT_TRUE(canvas[0][0] == ' ');
+    ASSERT_TRUE(canvas[0][1] == 'x');
+    ASSERT_TRUE(canvas[1][1] == 'x');
+    ASSERT_TRUE(canvas[2][1] == 'x');
+    ASSERT_TRUE(canvas[0][2] == ' ');
+}
+
+TEST(render_surface_test, tile_repeats_a_pattern_anchored_at_the_origin)
+{
+    using namespace terminalpp::literals;  // NOLINT
+
+    terminalpp::canvas canvas({4, 3});
+    munin::render_surface render_surface(canvas);
+
+    render_surface.tile({{1, 0}, {3, 3}}, {"ab"_ts, "xyz"_ts});
+
+    ASSERT_TRUE(canvas[0][0] == ' ');
+    ASSERT_TRUE(canvas[1][0] == 'b');
+    ASSERT_TRUE(canvas[2][0] == 'a');
+    ASSERT_TRUE(canvas[3][0] == 'b');
+    ASSERT_TRUE(canvas[1][1] == 'y');
+    ASSERT_TRUE(canvas[2][1] == 'z');
+    ASSERT_TRUE(canvas[3][1] == 'x');
+    ASSERT_TRUE(canvas[1][2] == 'b');
+    ASSERT_TRUE(canvas[2][2] == 'a');
+    ASSERT_TRUE(canvas[3][2] == 'b');
+}
+
+TEST(render_surface_test, tile_repeats_a_pattern_before_the_origin)
+{
+    using namespace terminalpp::literals;  // NOLINT
+
+    terminalpp::canvas canvas({3, 3});
+    munin::render_surface render_surface(canvas);
+    render_surface.offset_by({1, 1});
+
+    render_surface.tile({{-1, -1}, {3, 3}}, {"ab"_ts, "xyz"_ts});
+
+    ASSERT_TRUE(canvas[0][0] == 'z');
+    ASSERT_TRUE(canvas[1][0] == 'x');
+    ASSERT_TRUE(canvas[2][0] == 'y');
+    ASSERT_TRUE(canvas[0][1] == 'b');
+    ASSERT_TRUE(canvas[1][1] == 'a');
+    ASSERT_TRUE(canvas[2][1] == 'b');
+    ASSERT_TRUE(canvas[0][2] == 'z');
+    ASSERT_TRUE(canvas[1][2] == 'x');
+    ASSERT_TRUE(canvas[2][2] == 'y');
+}
+
+TEST(render_surface_test, clip_rect_is_the_whole_canvas_by_default)
+{
+    terminalpp::canvas canvas({3, 2});
+    munin::render_surface render_surface(canvas);
+
+    ASSERT_EQ(
+        (terminalpp::rectangle{{0, 0}, {3, 2}}), render_surface.clip_rect());
+
+    render_surface.offset_by({1, 1});
+
+    ASSERT_EQ(
+        (terminalpp::rectangle{{-1, -1}, {3, 2}}), render_surface.clip_rect());
+}
+
+TEST(render_surface_test, pushed_clips_are_intersected_and_popped)
+{
+    terminalpp::canvas canvas({4, 4});
+    munin::render_surface render_surface(canvas);
+
+    {
+        munin::render_surface::scoped_clip const outer{
+            render_surface, {{1, 1}, {3, 3}}};
+
+        ASSERT_EQ(
+            (terminalpp::rectangle{{1, 1}, {3, 3}}),
+            render_surface.clip_rect());
+
+        render_surface.offset_by({1, 1});
+
+        {
+            munin::render_surface::scoped_clip const inner{
+                render_surface, {{1, 1}, {5, 5}}};
+
+            ASSERT_EQ(
+                (terminalpp::rectangle{{1, 1}, {2, 2}}),
+                render_surface.clip_rect());
+        }
+
+        ASSERT_EQ(
+            (terminalpp::rectangle{{0, 0}, {3, 3}}),
+            render_surface.clip_rect());
+
+        render_surface.offset_by({-1, -1});
+    }
+
+    ASSERT_EQ(
+        (terminalpp::rectangle{{0, 0}, {4, 4}}), render_surface.clip_rect());
+}
+
+TEST(render_surface_test, writes_outside_the_clip_are_discarded)
+{
+    terminalpp::canvas canvas({3, 3});
+    munin::render_surface render_surface(canvas);
+
+    munin::render_surface::scoped_clip const clip{
+        render_surface, {{1, 1}, {1, 1}}};
+
+    render_surface[0][0] = 'a';
+    render_surface[1][1] = 'b';
+    render_surface.fill({{0, 0}, {3, 3}}, 'c');
+
+    ASSERT_TRUE(canvas[0][0] == ' ');
+    ASSERT_TRUE(canvas[1][1] == 'c');
+    ASSERT_TRUE(canvas[2][1] == ' ');
+    ASSERT_TRUE(canvas[1][2] == ' ');
+}
+
+TEST(render_surface_test, reads_outside_the_clip_return_the_canvas_content)
+{
+    terminalpp::canvas canvas({3, 3});
+    canvas[0][0] = 'a';
+    canvas[2][2] = 'b';
+
+    munin::render_surface render_surface(canvas);
+
+    munin::render_surface::scoped_clip const clip{
+        render_surface, {{1, 1}, {1, 1}}};
+
+    render_surface[0][0] = 'x';
+
+    ASSERT_TRUE(render_surface[2][2] == 'b');
+    ASSERT_TRUE(render_surface[0][0] == 'a');
+    ASSERT_TRUE(canvas[0][0] == 'a');
+}
+
+TEST(render_surface_test, records_only_elements_that_were_changed)
+{
+    terminalpp::canvas canvas({5, 2});
+    munin::dirty_spans dirty;
+    dirty.reset(canvas.size());
+
+    munin::default_render_surface_capabilities const capabilities;
+    munin::render_surface render_surface(canvas, capabilities, dirty);
+
+    terminalpp::element const elements[] = {' ', 'a', ' ', 'b', ' '};
+    render_surface.write_row({0, 0}, elements);
+    render_surface.fill({{0, 1}, {5, 1}}, ' ');
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{1, 0}, {3, 1}},
+    };
+
+    ASSERT_EQ(expected, dirty.rectangles());
+    ASSERT_TRUE(canvas[1][0] == 'a');
+    ASSERT_TRUE(canvas[3][0] == 'b');
+}
+
+TEST(render_surface_test, records_direct_access_as_changed)
+{
+    terminalpp::canvas canvas({5, 2});
+    munin::dirty_spans dirty;
+    dirty.reset(canvas.size());
+
+    munin::default_render_surface_capabilities const capabilities;
+    munin::render_surface render_surface(canvas, capabilities, dirty);
+
+    render_surface.offset_by({1, 1});
+    render_surface[2][0] = ' ';
+    static_cast<void>(render_surface.row_span({0, 0}, 2));
+
+    auto const expected = std::vector<terminalpp::rectangle>{
+        {{1, 1}, {3, 1}},
+    };
+
+    ASSERT_EQ(expected, dirty.rectangles());
+}
+
+TEST(render_surface_test, counts_the_cells_written_within_the_clip)
+{
+    terminalpp::canvas canvas({3, 3});
+    munin::render_surface render_surface(canvas);
+
+    terminalpp::element const elements[] = {'a', 'b', 'c'};
+    render_surface.write_row({0, 0}, elements);
+    render_surface.fill({{0, 1}, {2, 1}}, 'd');
+
+    ASSERT_EQ(5u, render_surface.cells_written());
+
+    munin::render_surface::scoped_clip const clip{
+        render_surface, {{1, 1}, {1, 1}}};
+
+    render_surface[0][0] = 'e';
+    render_surface[1][1] = 'f';
+    render_surface.fill({{0, 0}, {3, 3}}, 'g');
+
+    ASSERT_EQ(7u, render_surface.cells_written());
+}
+
+TEST(render_surface_test, does_not_count_cells_that_are_only_read)
+{
+    terminalpp::canvas canvas({3, 3});
+    canvas[1][1] = 'a';
+
+    munin::dirty_spans dirty;
+    dirty.reset(canvas.size());
+
+    munin::default_render_surface_capabilities const capabilities;
+    munin::render_surface render_surface(canvas, capabilities, dirty);
+    auto const &read_only_surface = render_surface;
+
+    ASSERT_TRUE(read_only_surface[1][1] == 'a');
+    ASSERT_TRUE(read_only_surface[5][5] == ' ');
+    ASSERT_EQ(0u, render_surface.cells_written());
+    ASSERT_TRUE(dirty.empty());
+}
@@ -0,0 +1,117 @@
+#include "mock/repaint_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace std::literals;
+using testing::_;
+using testing::Return;
+
+namespace {
+
+class a_repaint_scheduler : public testing::Test
+{
+protected:
+    a_repaint_scheduler() : now_(std::chrono::steady_clock::now())
+    {
+        ON_CALL(*scheduler_, do_now()).WillByDefault(Return(now_));
+
+        scheduler_->on_repaint.connect([this] { ++repaint_count_; });
+    }
+
+    std::shared_ptr<mock_repaint_scheduler> scheduler_{
+        make_mock_repaint_scheduler()};
+
+    std::chrono::steady_clock::time_point now_;
+
+    int repaint_count_{0};
+};
+
+}  // namespace
+
+TEST_F(a_repaint_scheduler, has_a_default_frame_interval_of_16ms)
+{
+    ASSERT_EQ(16ms, scheduler_->frame_interval());
+}
+
+TEST_F(a_repaint_scheduler, schedules_the_first_repaint_immediately)
+{
+    EXPECT_CALL(*scheduler_, reset_timer(now_));
+
+    scheduler_->request_repaint();
+
+    ASSERT_EQ(0, repaint_count_);
+}
+
+TEST_F(a_repaint_scheduler, does_not_repaint_when_a_frame_starts_with_no_request)
+{
+    scheduler_->start_frame();
+
+    ASSERT_EQ(0, repaint_count_);
+}
+
+TEST_F(a_repaint_scheduler, coalesces_requests_made_before_the_frame_starts)
+{
+    EXPECT_CALL(*scheduler_, reset_timer(_)).Times(1);
+
+    scheduler_->request_repaint();
+    scheduler_->request_repaint();
+    scheduler_->request_repaint();
+
+    scheduler_->start_frame();
+
+    ASSERT_EQ(1, repaint_count_);
+}
+
+namespace {
+
+class a_repaint_scheduler_that_has_just_repainted : public a_repaint_scheduler
+{
+protected:
+    a_repaint_scheduler_that_has_just_repainted()
+    {
+        scheduler_->set_frame_interval(33ms);
+        scheduler_->request_repaint();
+        scheduler_->start_frame();
+    }
+};
+
+}  // namespace
+
+TEST_F(
+    a_repaint_scheduler_that_has_just_repainted,
+    schedules_the_next_repaint_for_the_next_frame)
+{
+    ON_CALL(*scheduler_, do_now()).WillByDefault(Return(now_ + 10ms));
+    EXPECT_CALL(*scheduler_, reset_timer(now_ + 33ms));
+
+    scheduler_->request_repaint();
+}
+
+TEST_F(
+    a_repaint_scheduler_that_has_just_repainted,
+    schedules_the_next_repaint_immediately_if_the_frame_interval_has_passed)
+{
+    ON_CALL(*scheduler_, do_now()).WillByDefault(Return(now_ + 100ms));
+    EXPECT_CALL(*scheduler_, reset_timer(now_ + 100ms));
+
+    scheduler_->request_repaint();
+}
+
+TEST_F(
+    a_repaint_scheduler_that_has_just_repainted,
+    skips_missed_frames_when_running_late)
+{
+    ON_CALL(*scheduler_, do_now()).WillByDefault(Return(now_ + 10ms));
+    scheduler_->request_repaint();
+
+    // The frame was due at 33ms, but did not start until 100ms.  The next
+    // frame is paced from 100ms, not from 33ms.
+    ON_CALL(*scheduler_, do_now()).WillByDefault(Return(now_ + 100ms));
+    scheduler_->start_frame();
+    ASSERT_EQ(2, repaint_count_);
+
+    EXPECT_CALL(*scheduler_, reset_timer(now_ + 133ms));
+    scheduler_->request_repaint();
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <munin/detail/row_compare.hpp>
+
+#include <vector>
+
+using munin::compact_canvas;
+using munin::detail::row_difference;
+
+namespace {
+
+std::vector<compact_canvas::cell> make_row(std::size_t size)
+{
+    std::vector<compact_canvas::cell> row(size);
+
+    for (std::size_t index = 0; index < size; ++index)
+    {
+        row[index] = {static_cast<std::uint32_t>('a' + (index % 26)), 0};
+    }
+
+    return row;
+}
+
+}  // namespace
+
+TEST(comparing_rows, finds_no_difference_between_identical_rows)
+{
+    auto const lhs = make_row(37);
+    auto const rhs = lhs;
+
+    ASSERT_EQ(std::nullopt, munin::detail::compare_row(lhs, rhs));
+    ASSERT_EQ(std::nullopt, munin::detail::compare_row_scalar(lhs, rhs));
+}
+
+TEST(comparing_rows, finds_no_difference_between_empty_rows)
+{
+    std::vector<compact_canvas::cell> const empty;
+
+    ASSERT_EQ(std::nullopt, munin::detail::compare_row(empty, empty));
+}
+
+TEST(comparing_rows, finds_a_difference_in_either_half_of_a_cell)
+{
+    auto const lhs = make_row(8);
+    auto glyph_changed = lhs;
+    auto attribute_changed = lhs;
+
+    glyph_changed[5].glyph_ = '!';
+    attribute_changed[5].attribute_ = 1;
+
+    auto const expected = row_difference{5, 6};
+
+    ASSERT_EQ(expected, munin::detail::compare_row(lhs, glyph_changed));
+    ASSERT_EQ(expected, munin::detail::compare_row(lhs, attribute_changed));
+}
+
+TEST(comparing_rows, agrees_with_the_scalar_comparison_for_every_range)
+{
+    // Every combination of first and last difference in rows of several
+    // lengths, so that differences both inside and at the edges of blocks
+    // of cells are covered.
+    for (std::size_t size = 1; size <= 11; ++size)
+    {
+        auto const lhs = make_row(size);
+
+        for (std::size_t first = 0; first < size; ++first)
+        {
+            for (std::size_t last = first; last < size; ++last)
+            {
+                auto rhs = lhs;
+                rhs[first].glyph_ = '!';
+                rhs[last].attribute_ = 1;
+
+                auto const expected = row_difference{first, last + 1};
+
+                ASSERT_EQ(expected, munin::detail::compare_row(lhs, rhs));
+                ASSERT_EQ(
+                    expected, munin::detail::compare_row_scalar(lhs, rhs));
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <munin/detail/single_threaded_signal.hpp>
+
+#include <memory>
+#include <vector>
+
+using munin::detail::single_threaded_connection;
+using munin::detail::single_threaded_signal;
+
+TEST(a_new_single_threaded_signal, has_no_slots)
+{
+    single_threaded_signal<void()> sig;
+
+    ASSERT_TRUE(sig.empty());
+    ASSERT_EQ(0, sig.num_slots());
+
+    // Emitting a signal with no slots does nothing.
+    sig();
+}
+
+TEST(a_single_threaded_signal, calls_its_slots_in_the_order_they_connected)
+{
+    single_threaded_signal<void(int)> sig;
+    std::vector<int> calls;
+
+    sig.connect([&calls](int value) { calls.push_back(value); });
+    sig.connect([&calls](int value) { calls.push_back(value * 10); });
+    sig.connect([&calls](int value) { calls.push_back(value * 100); });
+
+    sig(3);
+
+    auto const expected = std::vector<int>{3, 30, 300};
+    ASSERT_EQ(expected, calls);
+    ASSERT_EQ(3, sig.num_slots());
+}
+
+TEST(a_single_threaded_signal, does_not_call_a_disconnected_slot)
+{
+    single_threaded_signal<void()> sig;
+    int first_calls = 0;
+    int second_calls = 0;
+
+    auto const cnx = sig.connect([&first_calls] { ++first_calls; });
+    sig.connect([&second_calls] { ++second_calls; });
+
+    ASSERT_TRUE(cnx.connected());
+    cnx.disconnect();
+    ASSERT_FALSE(cnx.connected());
+
+    sig();
+
+    ASSERT_EQ(0, first_calls);
+    ASSERT_EQ(1, second_calls);
+    ASSERT_EQ(1, sig.num_slots());
+}
+
+TEST(a_single_threaded_signal, allows_a_slot_to_disconnect_itself)
+{
+    single_threaded_signal<void()> sig;
+    single_threaded_connection cnx;
+    int calls = 0;
+
+    cnx = sig.connect([&cnx, &calls] {
+        ++calls;
+        cnx.disconnect();
+    });
+
+    sig();
+    sig();
+
+    ASSERT_EQ(1, calls);
+    ASSERT_TRUE(sig.empty());
+}
+
+TEST(
+    a_single_threaded_signal,
+    does_not_call_a_slot_disconnected_during_the_same_emission)
+{
+    single_threaded_signal<void()> sig;
+    single_threaded_connection second_cnx;
+    int second_calls = 0;
+
+    sig.connect([&second_cnx] { second_cnx.disconnect(); });
+    second_cnx = sig.connect([&second_calls] { ++second_calls; });
+
+    sig();
+
+    ASSERT_EQ(0, second_calls);
+    ASSERT_EQ(1, sig.num_slots());
+}
+
+TEST(
+    a_single_threaded_signal,
+    calls_a_slot_connected_during_an_emission_only_from_the_next_emission)
+{
+    single_threaded_signal<void()> sig;
+    int new_slot_calls = 0;
+    bool connected = false;
+
+    sig.connect([&] {
+        if (!connected)
+        {
+            connected = true;
+            sig.connect([&new_slot_calls] { ++new_slot_calls; });
+        }
+    });
+
+    sig();
+    ASSERT_EQ(0, new_slot_calls);
+    ASSERT_EQ(2, sig.num_slots());
+
+    sig();
+    ASSERT_EQ(1, new_slot_calls);
+}
+
+TEST(a_single_threaded_signal, can_have_all_of_its_slots_disconnected)
+{
+    single_threaded_signal<void()> sig;
+    int calls = 0;
+
+    auto const cnx = sig.connect([&calls] { ++calls; });
+    sig.connect([&calls] { ++calls; });
+
+    sig.disconnect_all_slots();
+    sig();
+
+    ASSERT_EQ(0, calls);
+    ASSERT_TRUE(sig.empty());
+    ASSERT_FALSE(cnx.connected());
+}
+
+TEST(a_single_threaded_signal, can_be_connected_to_another_signal)
+{
+    single_threaded_signal<void(int)> first;
+    single_threaded_signal<void(int)> second;
+    int received = 0;
+
+    second.connect([&received](int value) { received = value; });
+    first.connect(second);
+
+    first(42);
+
+    ASSERT_EQ(42, received);
+}
+
+TEST(
+    a_single_threaded_signal,
+    does_not_emit_a_connected_signal_that_has_been_destroyed)
+{
+    single_threaded_signal<void()> first;
+    auto second = std::make_unique<single_threaded_signal<void()>>();
+
+    first.connect(*second);
+    second.reset();
+
+    // This must not touch the destroyed signal.
+    first();
+}
+
+TEST(a_single_threaded_connection, can_outlive_its_signal)
+{
+    single_threaded_connection cnx;
+
+    {
+        single_threaded_signal<void()> sig;
+        cnx = sig.connect([] {});
+        ASSERT_TRUE(cnx.connected());
+    }
+
+    ASSERT_FALSE(cnx.connected());
+    cnx.disconnect();
+}
+
+TEST(a_single_threaded_signal, may_be_destroyed_by_one_of_its_slots)
+{
+    auto sig = std::make_unique<single_threaded_signal<void()>>();
+    int later_calls = 0;
+
+    sig->connect([&sig] { sig.reset(); });
+    sig->connect([&later_calls] { ++later_calls; });
+
+    (*sig)();
+
+    ASSERT_EQ(nullptr, sig);
+    ASSERT_EQ(0, later_calls);
+}
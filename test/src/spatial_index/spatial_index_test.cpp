@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <munin/detail/spatial_index.hpp>
+
+namespace {
+
+class a_spatial_index : public testing::Test
+{
+protected:
+    a_spatial_index()
+    {
+        // A 10x10 board of 1x1 cells, followed by a rectangle that overlaps
+        // the top-left corner of the board.
+        for (terminalpp::coordinate_type row = 0; row < 10; ++row)
+        {
+            for (terminalpp::coordinate_type column = 0; column < 10; ++column)
+            {
+                bounds_.push_back({
+                    {column, row},
+                    {1,      1  }
+                });
+            }
+        }
+
+        bounds_.push_back({
+            {0, 0},
+            {2, 2}
+        });
+
+        index_.rebuild(bounds_);
+    }
+
+    std::vector<terminalpp::rectangle> bounds_;
+    munin::detail::spatial_index index_;
+};
+
+}  // namespace
+
+TEST(a_new_spatial_index, finds_nothing)
+{
+    munin::detail::spatial_index index;
+
+    ASSERT_FALSE(index.find({0, 0}).has_value());
+    ASSERT_TRUE(index.query({{0, 0}, {10, 10}}).empty());
+}
+
+TEST_F(a_spatial_index, finds_the_lowest_index_at_a_point)
+{
+    ASSERT_EQ(std::size_t{0}, index_.find({0, 0}));
+    ASSERT_EQ(std::size_t{11}, index_.find({1, 1}));
+    ASSERT_EQ(std::size_t{99}, index_.find({9, 9}));
+}
+
+TEST_F(a_spatial_index, finds_nothing_outside_of_its_rectangles)
+{
+    ASSERT_FALSE(index_.find({10, 0}).has_value());
+    ASSERT_FALSE(index_.find({-1, 0}).has_value());
+}
+
+TEST_F(a_spatial_index, returns_intersecting_rectangles_in_ascending_order)
+{
+    auto const expected = std::vector<std::size_t>{0, 1, 10, 11, 100};
+
+    ASSERT_EQ(expected, index_.query({{0, 0}, {2, 2}}));
+}
+
+TEST_F(a_spatial_index, returns_each_rectangle_once_for_a_large_query)
+{
+    ASSERT_EQ(bounds_.size(), index_.query({{-5, -5}, {20, 20}}).size());
+}
+
+TEST_F(a_spatial_index, ignores_empty_rectangles)
+{
+    bounds_.push_back({
+        {5, 5},
+        {0, 0}
+    });
+    index_.rebuild(bounds_);
+
+    auto const expected = std::vector<std::size_t>{55};
+    ASSERT_EQ(expected, index_.query({{5, 5}, {1, 1}}));
+}
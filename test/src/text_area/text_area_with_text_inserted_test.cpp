@@ -151,6 +151,41 @@ TEST_F(
     ASSERT_EQ(expected_preferred_size, preferred_size);
 }
 
+TEST_F(
+    a_text_area_with_text_inserted,
+    announces_a_change_in_preferred_size_if_typing_wraps_onto_a_new_line)
+{
+    text_area_.set_size({3, 1});
+
+    auto preferred_size = terminalpp::extent{};
+    text_area_.on_preferred_size_changed.connect(
+        [&] { preferred_size = text_area_.get_preferred_size(); });
+
+    text_area_.event(terminalpp::virtual_key{
+        terminalpp::vk::lowercase_a, terminalpp::vk_modifier::none, 1});
+
+    static constexpr auto expected_preferred_size = terminalpp::extent{3, 2};
+    ASSERT_EQ(expected_preferred_size, preferred_size);
+}
+
+TEST_F(
+    a_text_area_with_text_inserted,
+    announces_a_change_in_preferred_size_if_deleting_removes_a_line)
+{
+    text_area_.set_size({3, 1});
+    text_area_.insert_text("c");
+
+    auto preferred_size = terminalpp::extent{};
+    text_area_.on_preferred_size_changed.connect(
+        [&] { preferred_size = text_area_.get_preferred_size(); });
+
+    text_area_.event(terminalpp::virtual_key{
+        terminalpp::vk::bs, terminalpp::vk_modifier::none, 1});
+
+    static constexpr auto expected_preferred_size = terminalpp::extent{3, 1};
+    ASSERT_EQ(expected_preferred_size, preferred_size);
+}
+
 namespace {
 
 using move_caret_test_data = std::tuple<
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <munin/filled_box.hpp>
+#include <munin/render_surface.hpp>
+#include <munin/trace.hpp>
+#include <terminalpp/canvas.hpp>
+
+#include <thread>
+
+namespace {
+
+munin::trace_event make_event(std::string type)
+{
+    munin::trace_event ev;
+    ev.category = "draw";
+    ev.type = std::move(type);
+    ev.thread = std::this_thread::get_id();
+    return ev;
+}
+
+}  // namespace
+
+TEST(a_trace_buffer, returns_recorded_events_in_order)
+{
+    munin::trace_buffer buffer{4};
+    buffer.record(make_event("a"));
+    buffer.record(make_event("b"));
+
+    auto const events = buffer.events();
+    ASSERT_EQ(2u, events.size());
+    ASSERT_EQ("a", events[0].type);
+    ASSERT_EQ("b", events[1].type);
+}
+
+TEST(a_full_trace_buffer, overwrites_the_oldest_events)
+{
+    munin::trace_buffer buffer{2};
+    buffer.record(make_event("a"));
+    buffer.record(make_event("b"));
+    buffer.record(make_event("c"));
+
+    auto const events = buffer.events();
+    ASSERT_EQ(2u, events.size());
+    ASSERT_EQ("b", events[0].type);
+    ASSERT_EQ("c", events[1].type);
+}
+
+TEST(a_trace_buffer, can_be_cleared)
+{
+    munin::trace_buffer buffer{2};
+    buffer.record(make_event("a"));
+    buffer.clear();
+
+    ASSERT_TRUE(buffer.events().empty());
+}
+
+TEST(a_trace_buffer, exports_chrome_trace_events)
+{
+    munin::trace_buffer buffer{2};
+    buffer.record(make_event("a"));
+
+    auto const json = buffer.to_json();
+    auto const &trace_events = json["traceEvents"];
+
+    ASSERT_EQ(1u, trace_events.size());
+    ASSERT_EQ("a", trace_events[0]["name"]);
+    ASSERT_EQ("draw", trace_events[0]["cat"]);
+    ASSERT_EQ("X", trace_events[0]["ph"]);
+}
+
+TEST(a_trace_buffer, exports_the_events_of_each_thread_separately)
+{
+    munin::trace_buffer buffer{4};
+    buffer.record(make_event("a"));
+    std::thread{[&buffer] { buffer.record(make_event("b")); }}.join();
+    buffer.record(make_event("c"));
+
+    auto const json = buffer.to_json();
+    auto const &trace_events = json["traceEvents"];
+
+    ASSERT_EQ(3u, trace_events.size());
+    ASSERT_EQ(1, trace_events[0]["tid"]);
+    ASSERT_EQ(2, trace_events[1]["tid"]);
+    ASSERT_EQ(1, trace_events[2]["tid"]);
+}
+
+TEST(drawing_a_component, records_a_trace_event)
+{
+    auto &buffer = munin::global_trace_buffer();
+    buffer.clear();
+
+    auto const fill = munin::make_fill('x');
+    fill->set_size({4, 4});
+
+    terminalpp::canvas cvs{{4, 4}};
+    munin::render_surface surface{cvs};
+    fill->draw(surface, {{1, 1}, {3, 2}});
+
+    auto const events = buffer.events();
+    ASSERT_EQ(1u, events.size());
+    ASSERT_EQ(std::string{"draw"}, events[0].category);
+    ASSERT_EQ("munin::filled_box", events[0].type);
+    ASSERT_EQ(6u, events[0].cells);
+}
@@ -28,6 +28,7 @@ TEST(
 {
     static constexpr terminalpp::extent comp_preferred_size{80, 24};
     auto comp = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp);
     std::shared_ptr<munin::component> mcomp = comp;
 
     EXPECT_CALL(*comp, do_get_preferred_size())
@@ -48,10 +49,12 @@ TEST(
     static constexpr terminalpp::extent expected_preferred_size{140, 24};
 
     auto comp0 = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp0);
     EXPECT_CALL(*comp0, do_get_preferred_size())
         .WillOnce(Return(comp0_preferred_size));
 
     auto comp1 = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp1);
     EXPECT_CALL(*comp1, do_get_preferred_size())
         .WillOnce(Return(comp1_preferred_size));
 
@@ -76,6 +79,7 @@ TEST(
     static constexpr terminalpp::extent expected_size{80, 40};
 
     auto comp = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp);
     EXPECT_CALL(*comp, do_get_preferred_size())
         .WillOnce(Return(comp_preferred_size));
 
@@ -101,14 +105,17 @@ TEST(
     static constexpr terminalpp::point expected2_pos{60, 0};
 
     auto comp0 = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp0);
     EXPECT_CALL(*comp0, do_get_preferred_size())
         .WillOnce(Return(comp_preferred_size));
 
     auto comp1 = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp1);
     EXPECT_CALL(*comp1, do_get_preferred_size())
         .WillOnce(Return(comp_preferred_size));
 
     auto comp2 = std::make_shared<StrictMock<mock_component>>();
+    unplace(*comp2);
     EXPECT_CALL(*comp2, do_get_preferred_size())
         .WillOnce(Return(comp_preferred_size));
 
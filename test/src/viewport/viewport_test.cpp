@@ -111,24 +111,17 @@ TEST_F(
 {
     auto const viewport_size = terminalpp::extent{5, 5};
     viewport_->set_size(viewport_size);
+    ASSERT_EQ(viewport_size, tracked_component_->get_size());
 
     {
         testing::InSequence _;
 
-        auto const preferred_size = terminalpp::extent{3, 3};
-        EXPECT_CALL(*tracked_component_, do_get_preferred_size)
-            .WillOnce(Return(preferred_size));
-        EXPECT_CALL(*tracked_component_, do_set_size(viewport_size));
-        tracked_component_->on_preferred_size_changed();
-    }
-
-    {
-        testing::InSequence _;
-
+        // The tracked component is already the size of the viewport, and so
+        // it is not resized again.
         auto const preferred_size = terminalpp::extent{2, 3};
         EXPECT_CALL(*tracked_component_, do_get_preferred_size)
             .WillOnce(Return(preferred_size));
-        EXPECT_CALL(*tracked_component_, do_set_size(viewport_size));
+        EXPECT_CALL(*tracked_component_, do_set_size(testing::_)).Times(0);
         tracked_component_->on_preferred_size_changed();
     }
 
@@ -176,11 +169,13 @@ TEST_F(
     {
         testing::InSequence _;
 
+        // The tracked component is already its preferred size, and so it
+        // is not resized again.
         auto const preferred_size = terminalpp::extent{17, 4};
         auto const new_viewport_size = terminalpp::extent{3, 3};
         EXPECT_CALL(*tracked_component_, do_get_preferred_size)
             .WillOnce(Return(preferred_size));
-        EXPECT_CALL(*tracked_component_, do_set_size(preferred_size));
+        EXPECT_CALL(*tracked_component_, do_set_size(testing::_)).Times(0);
         viewport_->set_size(new_viewport_size);
     }
 }
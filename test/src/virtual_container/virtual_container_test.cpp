@@ -0,0 +1,356 @@
+#include "assert_similar.hpp"
+#include "fill_canvas.hpp"
+#include "mock/component.hpp"
+
+#include <gtest/gtest.h>
+#include <munin/edit.hpp>
+#include <munin/grid_layout.hpp>
+#include <munin/image.hpp>
+#include <munin/render_surface.hpp>
+#include <munin/view.hpp>
+#include <munin/viewport.hpp>
+#include <munin/virtual_container.hpp>
+#include <terminalpp/canvas.hpp>
+#include <terminalpp/mouse.hpp>
+#include <terminalpp/virtual_key.hpp>
+
+#include <array>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace terminalpp::literals;  // NOLINT
+using testing::_;
+
+namespace {
+
+constexpr std::size_t row_count = 100;
+constexpr terminalpp::extent container_size{5, 100};
+
+// Rows are images of the form "rowNN", and so exactly fill the width of
+// the container.
+terminalpp::string row_text(std::size_t index)
+{
+    std::array<char, 8> text{};
+    std::snprintf(text.data(), text.size(), "row%02zu", index);
+    return terminalpp::string{std::string{text.data()}};
+}
+
+class a_virtual_container : public testing::Test
+{
+protected:
+    a_virtual_container()
+    {
+        container_->set_size(container_size);
+        fill_canvas(canvas_, 'X');
+    }
+
+    std::size_t rows_created_ = 0;
+    std::size_t rows_recycled_ = 0;
+
+    std::shared_ptr<munin::virtual_container> container_{
+        munin::make_virtual_container(
+            [this](std::size_t index, std::shared_ptr<munin::component> row) {
+                if (row)
+                {
+                    ++rows_recycled_;
+                    std::static_pointer_cast<munin::image>(row)->set_content(
+                        row_text(index));
+                    return row;
+                }
+
+                ++rows_created_;
+                return std::shared_ptr<munin::component>(
+                    munin::make_image(row_text(index)));
+            },
+            row_count)};
+
+    terminalpp::canvas canvas_{container_size};
+    munin::render_surface surface_{canvas_};
+};
+
+}  // namespace
+
+TEST_F(a_virtual_container, prefers_to_be_tall_enough_for_all_of_its_rows)
+{
+    auto const expected = terminalpp::extent{0, row_count};
+    ASSERT_EQ(expected, container_->get_preferred_size());
+}
+
+TEST_F(a_virtual_container, creates_no_rows_until_it_is_drawn)
+{
+    ASSERT_EQ(0u, rows_created_);
+    ASSERT_EQ(0u, container_->get_materialized_row_count());
+    ASSERT_EQ(std::optional<std::size_t>{0}, container_->get_current_row());
+}
+
+TEST_F(a_virtual_container, creates_and_draws_only_the_rows_that_are_drawn)
+{
+    container_->draw(surface_, {{0, 1}, {5, 2}});
+
+    ASSERT_EQ(2u, rows_created_);
+    ASSERT_EQ(2u, container_->get_materialized_row_count());
+
+    for (auto const row : {1, 2})
+    {
+        for (auto col = 0; col < 5; ++col)
+        {
+            ASSERT_EQ(row_text(row)[col], canvas_[col][row]);
+        }
+    }
+
+    ASSERT_EQ(terminalpp::element{'X'}, canvas_[0][0]);
+    ASSERT_EQ(terminalpp::element{'X'}, canvas_[0][3]);
+}
+
+TEST_F(a_virtual_container, recycles_rows_that_are_no_longer_drawn)
+{
+    container_->draw(surface_, {{0, 0}, {5, 3}});
+    container_->draw(surface_, {{0, 50}, {5, 3}});
+
+    ASSERT_EQ(3u, rows_created_);
+    ASSERT_EQ(3u, rows_recycled_);
+    ASSERT_EQ(3u, container_->get_materialized_row_count());
+
+    for (auto col = 0; col < 5; ++col)
+    {
+        ASSERT_EQ(row_text(51)[col], canvas_[col][51]);
+    }
+}
+
+TEST_F(a_virtual_container, keeps_rows_that_are_visible_when_one_is_redrawn)
+{
+    container_->draw(surface_, {{0, 0}, {5, 3}});
+    container_->draw(surface_, {{0, 1}, {5, 1}});
+
+    ASSERT_EQ(3u, container_->get_materialized_row_count());
+    ASSERT_EQ(3u, rows_created_);
+}
+
+TEST_F(a_virtual_container, draws_blank_space_below_its_rows)
+{
+    container_->set_row_count(2);
+    container_->draw(surface_, {{0, 0}, {5, 4}});
+
+    ASSERT_EQ(terminalpp::element{' '}, canvas_[0][2]);
+    ASSERT_EQ(terminalpp::element{' '}, canvas_[4][3]);
+    ASSERT_EQ(terminalpp::element{'X'}, canvas_[0][4]);
+}
+
+TEST_F(a_virtual_container, recycles_rows_beyond_a_reduced_row_count)
+{
+    bool preferred_size_changed = false;
+    container_->on_preferred_size_changed.connect(
+        [&preferred_size_changed] { preferred_size_changed = true; });
+
+    container_->draw(surface_, {{0, 0}, {5, 3}});
+    container_->set_row_count(1);
+
+    auto const expected_preferred_size = terminalpp::extent{0, 1};
+    ASSERT_TRUE(preferred_size_changed);
+    ASSERT_EQ(expected_preferred_size, container_->get_preferred_size());
+    ASSERT_EQ(1u, container_->get_materialized_row_count());
+}
+
+TEST_F(a_virtual_container, fetches_its_rows_again_when_they_are_refreshed)
+{
+    container_->draw(surface_, {{0, 0}, {5, 3}});
+    container_->refresh_rows();
+
+    ASSERT_EQ(0u, container_->get_materialized_row_count());
+
+    container_->draw(surface_, {{0, 0}, {5, 3}});
+    ASSERT_EQ(3u, rows_created_);
+    ASSERT_EQ(3u, rows_recycled_);
+}
+
+TEST_F(a_virtual_container, moves_its_cursor_between_rows_with_the_cursor_keys)
+{
+    int cursor_position_changes = 0;
+    container_->on_cursor_position_changed.connect(
+        [&cursor_position_changes] { ++cursor_position_changes; });
+
+    container_->event(terminalpp::virtual_key{terminalpp::vk::cursor_down});
+    container_->event(terminalpp::virtual_key{terminalpp::vk::cursor_down});
+    container_->event(terminalpp::virtual_key{terminalpp::vk::cursor_up});
+
+    auto const expected_position = terminalpp::point{0, 1};
+    ASSERT_EQ(std::optional<std::size_t>{1}, container_->get_current_row());
+    ASSERT_EQ(expected_position, container_->get_cursor_position());
+    ASSERT_EQ(3, cursor_position_changes);
+}
+
+TEST(a_virtual_container_of_tall_rows, sends_mouse_events_to_the_row_beneath)
+{
+    auto const row = make_mock_component();
+    std::size_t requested_index = 0;
+
+    auto const container = munin::make_virtual_container(
+        [&](std::size_t index, std::shared_ptr<munin::component> const &) {
+            requested_index = index;
+            return row;
+        },
+        10,
+        3);
+    container->set_size({5, 30});
+
+    std::optional<terminalpp::mouse::event> received;
+    EXPECT_CALL(*row, do_event(_)).WillOnce([&](std::any const &ev) {
+        if (auto const *mouse = std::any_cast<terminalpp::mouse::event>(&ev);
+            mouse != nullptr)
+        {
+            received = *mouse;
+        }
+    });
+
+    container->event(terminalpp::mouse::event{
+        terminalpp::mouse::event_type::left_button_down, {2, 7}
+    });
+
+    auto const expected_position = terminalpp::point{2, 1};
+    ASSERT_EQ(2u, requested_index);
+    ASSERT_EQ(std::optional<std::size_t>{2}, container->get_current_row());
+    ASSERT_TRUE(received.has_value());
+    ASSERT_EQ(expected_position, received->position_);
+}
+
+TEST(a_virtual_container_of_tall_rows, sends_other_keypresses_to_the_row)
+{
+    auto const row = make_mock_component();
+    auto const container = munin::make_virtual_container(
+        [&](std::size_t, std::shared_ptr<munin::component> const &) {
+            return row;
+        },
+        10,
+        3);
+
+    std::optional<terminalpp::virtual_key> received;
+    EXPECT_CALL(*row, do_event(_)).WillOnce([&](std::any const &ev) {
+        if (auto const *keypress = std::any_cast<terminalpp::virtual_key>(&ev);
+            keypress != nullptr)
+        {
+            received = *keypress;
+        }
+    });
+
+    container->event(terminalpp::virtual_key{terminalpp::vk::lowercase_z});
+
+    ASSERT_TRUE(received.has_value());
+    ASSERT_EQ(terminalpp::vk::lowercase_z, received->key);
+}
+
+TEST(
+    a_virtual_container_of_tall_rows,
+    keeps_a_row_alive_while_it_refreshes_the_rows)
+{
+    // A row may remove itself from the container, for example with a button
+    // that removes the entry that it shows, and it must not be destroyed
+    // while it is still handling the keypress that did so.
+    std::shared_ptr<munin::virtual_container> container;
+    std::weak_ptr<munin::component> created_row;
+    bool row_alive_after_refresh = false;
+
+    container = munin::make_virtual_container(
+        [&](std::size_t, std::shared_ptr<munin::component> const &) {
+            auto row = make_mock_component();
+            created_row = row;
+
+            ON_CALL(*row, do_event(_)).WillByDefault([&](std::any const &) {
+                container->refresh_rows();
+                row_alive_after_refresh = !created_row.expired();
+            });
+
+            return std::shared_ptr<munin::component>(row);
+        },
+        10,
+        3);
+
+    container->event(terminalpp::virtual_key{terminalpp::vk::lowercase_z});
+
+    ASSERT_TRUE(row_alive_after_refresh);
+}
+
+TEST(a_virtual_container_of_views, gives_focus_to_the_current_row)
+{
+    // Each row is a view of an edit, which only receives keypresses while it
+    // has focus.
+    std::vector<std::shared_ptr<munin::edit>> edits;
+    auto const container = munin::make_virtual_container(
+        [&](std::size_t index, std::shared_ptr<munin::component> const &) {
+            if (edits.size() <= index)
+            {
+                edits.resize(index + 1);
+            }
+
+            edits[index] = munin::make_edit();
+            return std::shared_ptr<munin::component>(munin::view(
+                munin::make_grid_layout({1, 1}), edits[index]));
+        },
+        10);
+    container->set_size({5, 10});
+
+    container->set_focus();
+    container->event(terminalpp::virtual_key{terminalpp::vk::lowercase_z});
+
+    ASSERT_EQ(1u, edits.size());
+    ASSERT_TRUE(edits[0]->has_focus());
+    ASSERT_EQ("z"_ts, edits[0]->get_text());
+    ASSERT_TRUE(container->get_cursor_state());
+    ASSERT_EQ((terminalpp::point{1, 0}), container->get_cursor_position());
+
+    container->event(terminalpp::virtual_key{terminalpp::vk::cursor_down});
+    container->event(terminalpp::virtual_key{terminalpp::vk::lowercase_t});
+
+    ASSERT_EQ(2u, edits.size());
+    ASSERT_FALSE(edits[0]->has_focus());
+    ASSERT_TRUE(edits[1]->has_focus());
+    ASSERT_EQ("t"_ts, edits[1]->get_text());
+    ASSERT_EQ((terminalpp::point{1, 1}), container->get_cursor_position());
+
+    container->lose_focus();
+
+    ASSERT_FALSE(edits[1]->has_focus());
+    ASSERT_FALSE(container->get_cursor_state());
+}
+
+TEST(a_virtual_container_in_a_viewport, creates_only_the_visible_rows)
+{
+    std::size_t rows_created = 0;
+    auto const container = munin::make_virtual_container(
+        [&rows_created](std::size_t index, std::shared_ptr<munin::component>) {
+            ++rows_created;
+            return std::shared_ptr<munin::component>(
+                munin::make_image(row_text(index)));
+        },
+        1000);
+
+    auto const viewport = munin::make_viewport(container);
+    constexpr auto viewport_size = terminalpp::extent{5, 4};
+    viewport->set_size(viewport_size);
+
+    terminalpp::canvas canvas{viewport_size};
+    munin::render_surface surface{canvas};
+    viewport->draw(surface, {{}, viewport_size});
+
+    ASSERT_EQ(4u, container->get_materialized_row_count());
+
+    for (auto index = 0; index < 10; ++index)
+    {
+        viewport->event(terminalpp::virtual_key{terminalpp::vk::cursor_down});
+    }
+
+    viewport->draw(surface, {{}, viewport_size});
+
+    ASSERT_EQ(4u, container->get_materialized_row_count());
+    assert_similar_canvas_block(
+        {
+            // clang-format off
+            "row07"_ts,
+            "row08"_ts,
+            "row09"_ts,
+            "row10"_ts,
+            // clang-format on
+        },
+        canvas);
+}
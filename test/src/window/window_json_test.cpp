@@ -16,4 +16,20 @@ TEST_F(a_window, reports_attributes_as_json)
 
     nlohmann::json content_json = json["content"];
     ASSERT_EQ("mock_content", content_json["type"]);
-}
\ No newline at end of file
+}
+
+TEST_F(a_window, reports_statistics_as_json)
+{
+    content_->on_redraw({
+        {{}, {1, 1}}
+    });
+
+    nlohmann::json json = window_->to_json();
+    nlohmann::json statistics_json = json["statistics"];
+
+    ASSERT_EQ(1, statistics_json["repaint_requests"]);
+    ASSERT_EQ(1, statistics_json["regions_requested"]);
+    ASSERT_EQ(0, statistics_json["repaints"]);
+    ASSERT_EQ(0, statistics_json["cells_written"]);
+    ASSERT_EQ(0, statistics_json["bytes_emitted"]);
+}
@@ -2,18 +2,20 @@
 #include "window_test.hpp"
 
 #include <gtest/gtest.h>
+#include <munin/render_surface.hpp>
 #include <terminalpp/algorithm/for_each_in_region.hpp>
 #include <terminalpp/canvas.hpp>
 #include <terminalpp/screen.hpp>
 #include <terminalpp/terminal.hpp>
 
+#include <utility>
+
 using namespace terminalpp::literals;  // NOLINT
 using testing::_;
 using testing::InSequence;
 using testing::Return;
 using testing::ReturnPointee;
 using testing::SaveArg;
-using testing::WithArgs;
 
 TEST_F(a_window, requests_a_repaint_when_content_requests_a_redraw)
 {
@@ -79,9 +81,10 @@ protected:
         fill_canvas(canvas_, 0);
 
         ON_CALL(*content_, do_draw(_, _))
-            .WillByDefault(WithArgs<1>([this](auto const &region) {
-                this->increment_elements_within(region);
-            }));
+            .WillByDefault([](munin::render_surface &surface,
+                              terminalpp::rectangle const &region) {
+                increment_elements_within(surface, region);
+            });
 
         // TODO: mock impl of set/get size
         ON_CALL(*content_, do_set_size(_))
@@ -91,10 +94,11 @@ protected:
             .WillByDefault(ReturnPointee(&content_size_));
     }
 
-    void increment_elements_within(terminalpp::rectangle const &region)
+    static void increment_elements_within(
+        munin::render_surface &surface, terminalpp::rectangle const &region)
     {
         terminalpp::for_each_in_region(
-            canvas_,
+            surface,
             region,
             [](terminalpp::element &elem,
                terminalpp::coordinate_type column,  // NOLINT
@@ -243,6 +247,38 @@ TEST_F(
         });
 }
 
+TEST_F(
+    repainting_a_window,
+    after_a_repaint_with_overlapping_regions_repaints_each_cell_only_once)
+{
+    window_->repaint(canvas_);
+    fill_canvas(canvas_, 0);
+
+    content_->on_redraw({
+        {{0, 0}, {4, 4}},
+        {{2, 2}, {4, 4}}
+    });
+    content_->on_redraw({
+        {{0, 0}, {4, 4}}
+    });
+    window_->repaint(canvas_);
+
+    terminalpp::for_each_in_region(
+        canvas_,
+        {{}, window_size},
+        [](terminalpp::element &elem,
+           terminalpp::coordinate_type column,
+           terminalpp::coordinate_type row) {
+            bool const in_first = column < 4 && row < 4;
+            bool const in_second =
+                column >= 2 && column < 6 && row >= 2 && row < 6;
+            int const expected = (in_first || in_second) ? 1 : 0;
+
+            ASSERT_EQ(expected, elem.glyph_.character_)
+                << "row = " << row << ", column = " << column;
+        });
+}
+
 TEST_F(repainting_a_window, with_no_changes_returns_empty_paint_data)
 {
     window_->repaint(canvas_);
@@ -257,3 +293,126 @@ TEST_F(repainting_a_window, with_no_changes_returns_empty_paint_data)
     auto const expected_repaint_output = ""_tb;
     ASSERT_EQ(expected_repaint_output, channel_.written);
 }
+
+TEST_F(
+    repainting_a_window,
+    with_damage_that_does_not_change_the_canvas_writes_nothing)
+{
+    window_->repaint(canvas_);
+
+    ON_CALL(*content_, do_draw(_, _)).WillByDefault(Return());
+    content_->on_redraw({
+        {{}, window_size}
+    });
+    channel_.written.clear();
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(""_tb, channel_.written);
+}
+
+TEST_F(repainting_a_window, writes_changes_within_the_damaged_region)
+{
+    window_->repaint(canvas_);
+
+    content_->on_redraw({
+        {{1, 1}, {1, 1}}
+    });
+    channel_.written.clear();
+
+    window_->repaint(canvas_);
+
+    // The expected output is found by replaying the same frames onto a
+    // second terminal, so that it also accounts for any state (such as the
+    // cursor position) that the terminal carries from the first frame.
+    // After the first frame, in which every cell was drawn once, only the
+    // cell that was drawn again is written.
+    fake_channel expected_channel;
+    terminalpp::terminal expected_terminal{expected_channel};
+    terminalpp::element const drawn_once{terminalpp::glyph(1)};
+    terminalpp::element const drawn_twice{terminalpp::glyph(2)};
+
+    for (terminalpp::coordinate_type row = 0; row < window_size.height_;
+         ++row)
+    {
+        expected_terminal
+            << terminalpp::move_cursor({0, row})
+            << terminalpp::string(
+                   static_cast<std::size_t>(window_size.width_), drawn_once);
+    }
+
+    expected_channel.written.clear();
+    expected_terminal << terminalpp::move_cursor({1, 1})
+                      << terminalpp::string{drawn_twice};
+
+    ASSERT_EQ(expected_channel.written, channel_.written);
+}
+
+TEST_F(repainting_a_window, writes_the_first_frame_in_a_single_write)
+{
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(1, channel_.writes);
+}
+
+TEST_F(repainting_a_window, writes_all_changes_in_a_single_write)
+{
+    window_->repaint(canvas_);
+
+    // Each of these regions is written as a separate run of cells, with a
+    // cursor movement before it.
+    content_->on_redraw({
+        {{1, 1},  {1, 1}},
+        {{5, 3},  {2, 1}},
+        {{10, 7}, {1, 2}}
+    });
+    channel_.writes = 0;
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(1, channel_.writes);
+}
+
+TEST_F(
+    repainting_a_window,
+    compares_every_damaged_cell_of_a_canvas_that_has_been_replaced)
+{
+    window_->repaint(canvas_);
+    auto const cells_changed = window_->statistics().cells_changed;
+
+    // Moving a new canvas into the old one keeps its address, but not its
+    // elements.  The damaged cell differs from the last frame even though
+    // drawing does not change it, and so must still be written.
+    terminalpp::canvas replacement(window_size);
+    fill_canvas(replacement, 1);
+    replacement[1][1].glyph_.character_ = 2;
+    canvas_ = std::move(replacement);
+
+    ON_CALL(*content_, do_draw(_, _)).WillByDefault(Return());
+    content_->on_redraw({
+        {{1, 1}, {1, 1}}
+    });
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(cells_changed + 1, window_->statistics().cells_changed);
+}
+
+TEST_F(repainting_a_window, does_not_compare_cells_outside_the_damaged_region)
+{
+    window_->repaint(canvas_);
+
+    // Modify a cell behind the window's back.  Since it is not part of any
+    // damaged region, it is not considered when diffing the frame.
+    ++canvas_[10][10].glyph_.character_;
+
+    ON_CALL(*content_, do_draw(_, _)).WillByDefault(Return());
+    content_->on_redraw({
+        {{1, 1}, {1, 1}}
+    });
+    channel_.written.clear();
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(""_tb, channel_.written);
+}
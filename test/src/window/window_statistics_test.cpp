@@ -0,0 +1,139 @@
+#include "fill_canvas.hpp"
+#include "window_test.hpp"
+
+#include <gtest/gtest.h>
+#include <terminalpp/canvas.hpp>
+
+using testing::_;
+using testing::Return;
+
+TEST_F(a_window, has_no_statistics_when_new)
+{
+    auto const &stats = window_->statistics();
+
+    ASSERT_EQ(0u, stats.repaint_requests);
+    ASSERT_EQ(0u, stats.repaints);
+    ASSERT_EQ(0u, stats.regions_requested);
+    ASSERT_EQ(0u, stats.regions_drawn);
+    ASSERT_EQ(0u, stats.region_area);
+    ASSERT_EQ(0u, stats.cells_written);
+    ASSERT_EQ(0u, stats.cells_changed);
+    ASSERT_EQ(0u, stats.bytes_emitted);
+}
+
+TEST_F(a_window, counts_repaint_requests_and_requested_regions)
+{
+    content_->on_redraw({
+        {{0, 0}, {2, 2}},
+        {{1, 1}, {2, 2}}
+    });
+    content_->on_redraw({
+        {{0, 0}, {2, 2}}
+    });
+
+    auto const &stats = window_->statistics();
+    ASSERT_EQ(2u, stats.repaint_requests);
+    ASSERT_EQ(3u, stats.regions_requested);
+}
+
+namespace {
+
+class a_painted_window : public a_window_test_base, public testing::Test
+{
+protected:
+    a_painted_window() : canvas_(window_size)
+    {
+        fill_canvas(canvas_, 0);
+
+        ON_CALL(*content_, do_get_size()).WillByDefault(Return(window_size));
+        window_->repaint(canvas_);
+    }
+
+    static constexpr terminalpp::extent const window_size{10, 10};
+
+    terminalpp::canvas canvas_;
+};
+
+}  // namespace
+
+TEST_F(a_painted_window, counts_the_whole_first_frame_as_changed)
+{
+    auto const &stats = window_->statistics();
+
+    ASSERT_EQ(1u, stats.repaints);
+    ASSERT_EQ(100u, stats.cells_changed);
+}
+
+TEST_F(a_painted_window, counts_coalesced_regions_and_changed_cells)
+{
+    ON_CALL(*content_, do_draw(_, _))
+        .WillByDefault([](munin::render_surface &surface,
+                          terminalpp::rectangle const &region) {
+            ++surface[1][1].glyph_.character_;
+        });
+
+    content_->on_redraw({
+        {{0, 0}, {2, 2}},
+        {{0, 0}, {2, 2}},
+        {{0, 0}, {2, 1}}
+    });
+
+    window_->repaint(canvas_);
+
+    auto const &stats = window_->statistics();
+    ASSERT_EQ(2u, stats.repaints);
+    ASSERT_EQ(3u, stats.regions_requested);
+    ASSERT_EQ(1u, stats.regions_drawn);
+    ASSERT_EQ(4u, stats.region_area);
+    ASSERT_EQ(101u, stats.cells_changed);
+}
+
+TEST_F(a_painted_window, counts_the_cells_written_by_the_content)
+{
+    ON_CALL(*content_, do_draw(_, _))
+        .WillByDefault([](munin::render_surface &surface,
+                          terminalpp::rectangle const &region) {
+            surface.fill(region, 'x');
+        });
+
+    content_->on_redraw({
+        {{0, 0}, {3, 2}}
+    });
+
+    window_->repaint(canvas_);
+
+    auto const &stats = window_->statistics();
+    ASSERT_EQ(6u, stats.cells_written);
+}
+
+TEST_F(a_painted_window, counts_the_bytes_written_to_the_terminal)
+{
+    ASSERT_EQ(channel_.written.size(), window_->statistics().bytes_emitted);
+
+    ON_CALL(*content_, do_draw(_, _))
+        .WillByDefault([](munin::render_surface &surface,
+                          terminalpp::rectangle const &region) {
+            surface.fill(region, 'x');
+        });
+
+    content_->on_redraw({
+        {{0, 0}, {3, 2}}
+    });
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(channel_.written.size(), window_->statistics().bytes_emitted);
+}
+
+TEST_F(a_painted_window, does_not_count_bytes_written_outside_a_repaint)
+{
+    auto const bytes_emitted = window_->statistics().bytes_emitted;
+
+    terminal_ << terminalpp::move_cursor({0, 0}) << "xyz";
+
+    ASSERT_EQ(bytes_emitted, window_->statistics().bytes_emitted);
+
+    window_->repaint(canvas_);
+
+    ASSERT_EQ(bytes_emitted, window_->statistics().bytes_emitted);
+}
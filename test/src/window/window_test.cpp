@@ -1,6 +1,7 @@
 #include "window_test.hpp"
 
 #include <gtest/gtest.h>
+#include <terminalpp/virtual_key.hpp>
 
 using testing::_;
 using testing::SaveArg;
@@ -20,3 +21,24 @@ TEST_F(a_window, passes_events_to_the_content)
     auto *ptag = std::any_cast<tag>(&result);
     ASSERT_NE(nullptr, ptag);
 }
+
+TEST_F(a_window, passes_keypresses_to_the_content)
+{
+    std::any result;
+
+    EXPECT_CALL(*content_, do_event(_)).WillOnce(SaveArg<0>(&result));
+
+    window_->event(terminalpp::virtual_key{terminalpp::vk::enter});
+
+    auto *pvk = std::any_cast<terminalpp::virtual_key>(&result);
+    ASSERT_NE(nullptr, pvk);
+    ASSERT_EQ(terminalpp::vk::enter, pvk->key);
+}
+
+TEST_F(a_window, reports_itself_and_its_content_in_its_census)
+{
+    auto const cen = window_->census();
+
+    ASSERT_EQ(1u, cen.types().at("munin::window").instances);
+    ASSERT_EQ(2u, cen.totals().instances);
+}
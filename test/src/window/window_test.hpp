@@ -3,6 +3,8 @@
 #include "fake/channel.hpp"
 #include "mock/component.hpp"
 
+#include <munin/batching_channel.hpp>
+#include <munin/byte_counting_channel.hpp>
 #include <munin/window.hpp>
 #include <terminalpp/terminal.hpp>
 
@@ -13,10 +15,18 @@ class a_window_test_base
 protected:
     a_window_test_base() : window_(new munin::window(terminal_, content_))
     {
+        window_->measure_output(
+            [this] { return counting_channel_.bytes_written(); });
+        window_->batch_output(
+            [this] { batching_channel_.begin_batch(); },
+            [this] { batching_channel_.end_batch(); });
     }
 
     fake_channel channel_;
-    terminalpp::terminal terminal_{channel_};
+    munin::byte_counting_channel<fake_channel> counting_channel_{channel_};
+    munin::batching_channel<munin::byte_counting_channel<fake_channel>>
+        batching_channel_{counting_channel_};
+    terminalpp::terminal terminal_{batching_channel_};
 
     std::shared_ptr<mock_component> content_{make_mock_component()};
     std::unique_ptr<munin::window> window_;